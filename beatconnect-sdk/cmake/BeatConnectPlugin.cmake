@@ -12,10 +12,28 @@
 #   # Apply BeatConnect configuration
 #   beatconnect_configure_plugin(MyPlugin)
 #
+#   # Optionally build one source once per instruction set (see below)
+#   beatconnect_configure_plugin(MyPlugin SIMD_DISPATCH_SOURCE Source/DSP/Kernels.cpp)
+#
 # Options (set BEFORE including this file):
 #   BEATCONNECT_USE_WEBUI          - Enable WebView UI (default: auto-detect)
 #   BEATCONNECT_ENABLE_ACTIVATION  - Enable license activation (default: OFF)
 #   BEATCONNECT_DEV_MODE           - Enable hot reload for WebUI (default: OFF)
+#   BEATCONNECT_SIMD_VARIANTS      - Extra x86 variants of the dispatch source
+#                                    (default: "AVX2;AVX512", empty = baseline only)
+#
+# SIMD dispatch:
+#   The SIMD_DISPATCH_SOURCE is compiled once for the baseline (SSE2 on x86,
+#   NEON on arm64) and once per extra variant. Each build sees
+#   BEATCONNECT_SIMD_ISA (Baseline, Avx2 or Avx512) plus BEATCONNECT_SIMD_AVX2
+#   or BEATCONNECT_SIMD_AVX512, and should put its code in a namespace named
+#   after BEATCONNECT_SIMD_ISA and enable the instruction set itself. The
+#   rest of the plugin sees BEATCONNECT_SIMD_HAS_AVX2 / _AVX512 and picks a
+#   variant at runtime.
+#
+#   Other targets that compile the plugin's DSP (tools, tests) get the same
+#   variants with:
+#     beatconnect_add_simd_dispatch(MyTool Source/DSP/Kernels.cpp)
 #
 # ==============================================================================
 
@@ -46,6 +64,7 @@ endif()
 
 option(BEATCONNECT_ENABLE_ACTIVATION "Enable BeatConnect license activation" OFF)
 option(BEATCONNECT_DEV_MODE "Enable development mode with hot reload" OFF)
+set(BEATCONNECT_SIMD_VARIANTS "AVX2;AVX512" CACHE STRING "Extra x86 instruction set variants of the SIMD dispatch source")
 
 # ==============================================================================
 # JUCE Fetch (if not already available)
@@ -68,6 +87,8 @@ endmacro()
 # Main Configuration Function
 # ==============================================================================
 function(beatconnect_configure_plugin TARGET_NAME)
+    cmake_parse_arguments(ARG "" "SIMD_DISPATCH_SOURCE" "" ${ARGN})
+
     # =========================================================================
     # Base compile definitions (all plugins)
     # =========================================================================
@@ -141,6 +162,13 @@ function(beatconnect_configure_plugin TARGET_NAME)
     # =========================================================================
     _beatconnect_setup_project_data(${TARGET_NAME})
 
+    # =========================================================================
+    # SIMD dispatch variants
+    # =========================================================================
+    if(ARG_SIMD_DISPATCH_SOURCE)
+        _beatconnect_setup_simd_variants(${TARGET_NAME} "${ARG_SIMD_DISPATCH_SOURCE}")
+    endif()
+
     # =========================================================================
     # Recommended libraries and flags
     # =========================================================================
@@ -253,6 +281,55 @@ function(_beatconnect_setup_project_data TARGET_NAME)
     endif()
 endfunction()
 
+# ==============================================================================
+# Internal: Build the SIMD dispatch source once per instruction set
+# ==============================================================================
+function(_beatconnect_setup_simd_variants TARGET_NAME DISPATCH_SOURCE)
+    get_filename_component(DISPATCH_SOURCE "${DISPATCH_SOURCE}" ABSOLUTE BASE_DIR "${BEATCONNECT_PLUGIN_SOURCE_DIR}")
+    set(VARIANT_DIR "${CMAKE_CURRENT_BINARY_DIR}/${TARGET_NAME}_simd")
+
+    # The source itself is only ever built through the wrappers
+    target_sources(${TARGET_NAME} PRIVATE "${DISPATCH_SOURCE}")
+    set_source_files_properties("${DISPATCH_SOURCE}" PROPERTIES HEADER_FILE_ONLY TRUE)
+
+    set(VARIANTS Baseline)
+    foreach(VARIANT ${BEATCONNECT_SIMD_VARIANTS})
+        string(TOUPPER "${VARIANT}" VARIANT_UPPER)
+        if(VARIANT_UPPER STREQUAL "AVX2")
+            list(APPEND VARIANTS Avx2)
+        elseif(VARIANT_UPPER STREQUAL "AVX512")
+            list(APPEND VARIANTS Avx512)
+        else()
+            message(WARNING "[BeatConnect] Unknown SIMD variant '${VARIANT}' (expected AVX2 or AVX512)")
+        endif()
+    endforeach()
+
+    foreach(ISA ${VARIANTS})
+        string(TOUPPER "${ISA}" ISA_UPPER)
+        set(WRAPPER "${VARIANT_DIR}/${ISA}.cpp")
+
+        if(ISA STREQUAL "Baseline")
+            set(ISA_DEFINE "")
+        else()
+            set(ISA_DEFINE "#define BEATCONNECT_SIMD_${ISA_UPPER} 1\n")
+            target_compile_definitions(${TARGET_NAME} PRIVATE BEATCONNECT_SIMD_HAS_${ISA_UPPER}=1)
+        endif()
+
+        file(CONFIGURE OUTPUT "${WRAPPER}" CONTENT
+            "// Generated by BeatConnectPlugin.cmake - do not edit\n#define BEATCONNECT_SIMD_ISA ${ISA}\n${ISA_DEFINE}#include \"${DISPATCH_SOURCE}\"\n")
+        target_sources(${TARGET_NAME} PRIVATE "${WRAPPER}")
+    endforeach()
+
+    message(STATUS "[BeatConnect] SIMD dispatch variants for ${TARGET_NAME}: ${VARIANTS}")
+endfunction()
+
+# ==============================================================================
+# Helper: SIMD dispatch for targets other than the plugin (tools, tests)
+# ==============================================================================
+function(beatconnect_add_simd_dispatch TARGET_NAME DISPATCH_SOURCE)
+    _beatconnect_setup_simd_variants(${TARGET_NAME} "${DISPATCH_SOURCE}")
+endfunction()
+
 # ==============================================================================
 # Helper: Get appropriate NEEDS_WEBVIEW2 value for juce_add_plugin
 # ==============================================================================
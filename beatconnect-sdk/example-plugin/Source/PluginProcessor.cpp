@@ -1,6 +1,12 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
 #include "ParameterIDs.h"
+#include <juce_gui_extra/juce_gui_extra.h>
+
+// The web view editor needs JUCE_WEB_BROWSER; builds without it (such as
+// the realtime tests) fall back to the generic editor
+#if JUCE_WEB_BROWSER
+ #include "PluginEditor.h"
+#endif
 
 ExamplePluginProcessor::ExamplePluginProcessor()
     : AudioProcessor(BusesProperties()
@@ -113,7 +119,11 @@ void ExamplePluginProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
 
 juce::AudioProcessorEditor* ExamplePluginProcessor::createEditor()
 {
+#if JUCE_WEB_BROWSER
     return new ExamplePluginEditor(*this);
+#else
+    return new juce::GenericAudioProcessorEditor(*this);
+#endif
 }
 
 void ExamplePluginProcessor::getStateInformation(juce::MemoryBlock& destData)
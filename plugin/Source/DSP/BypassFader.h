@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+    DelayWave - Bypass Fader
+    Gain of the processed signal against the dry one while bypass is
+    switched: 1 = processed, 0 = bypassed. Moves linearly over a few
+    milliseconds, so a bypass change (or automation flipping it back and
+    forth) never steps the output. What the gain is applied to depends on
+    the tail policy and is up to the processor.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ControlSignal.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace DelayWaveDSP
+{
+    class BypassFader
+    {
+    public:
+        static constexpr double defaultFadeSeconds = 0.005;
+
+        //==============================================================================
+        // Starts settled in the given state, without a fade
+        void prepare(double sampleRate, bool startBypassed, double fadeSeconds = defaultFadeSeconds)
+        {
+            step = 1.0f / static_cast<float>(std::max(1.0, std::round(fadeSeconds * sampleRate)));
+            bypassed = startBypassed;
+            fading = false;
+            gain = bypassed ? 0.0f : 1.0f;
+        }
+
+        void setBypassed(bool shouldBeBypassed) noexcept
+        {
+            fading = fading || shouldBeBypassed != bypassed;
+            bypassed = shouldBeBypassed;
+        }
+
+        // Settled in bypass: the processed signal is no longer heard
+        bool isBypassed() const noexcept { return bypassed && ! fading; }
+        bool isFading() const noexcept { return fading; }
+
+        //==============================================================================
+        // Advances the fade by numSamples. While fading, the gains are
+        // written into buffer (at least numSamples long) and returned as a
+        // ramp; otherwise the settled gain comes back as a constant.
+        ControlSignal process(float* buffer, int numSamples) noexcept
+        {
+            if (! fading)
+                return ControlSignal::constant(gain);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                gain = bypassed ? std::max(0.0f, gain - step) : std::min(1.0f, gain + step);
+                buffer[i] = gain;
+            }
+
+            // The clamps land exactly on the end of the fade
+            fading = bypassed ? gain > 0.0f : gain < 1.0f;
+            return ControlSignal::perSample(buffer);
+        }
+
+    private:
+        //==============================================================================
+        float gain = 1.0f;
+        float step = 1.0f;
+        bool bypassed = false;
+        bool fading = false;
+    };
+}
@@ -0,0 +1,25 @@
+/*
+  ==============================================================================
+    DelayWave - Control Signal
+    A control input for one block: either a per-sample array (while the
+    value is moving) or a single constant. Kernels check isConstant() once
+    per block and pick a specialised loop.
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace DelayWaveDSP
+{
+    struct ControlSignal
+    {
+        const float* ramp = nullptr;    // Per-sample values, or nullptr when constant
+        float value = 0.0f;             // Constant value (or the value at the end of the ramp)
+
+        static ControlSignal constant(float v) noexcept         { return { nullptr, v }; }
+        static ControlSignal perSample(const float* data) noexcept { return { data, 0.0f }; }
+
+        bool isConstant() const noexcept { return ramp == nullptr; }
+        float operator[](int i) const noexcept { return ramp != nullptr ? ramp[i] : value; }
+    };
+}
@@ -0,0 +1,345 @@
+/*
+  ==============================================================================
+    DelayWave - CPU Load Meter
+    How much of each block's deadline (its length in real time) processing
+    took. The audio thread times blocks with the CPU's cycle counter and
+    adds each load to the histogram of the current window. Any other thread
+    can end the window; the audio thread then publishes its summary (min,
+    mean, p99, max and overruns) and starts the next one at the end of its
+    next block, so every block is counted in exactly one window.
+
+    The histogram has 8 buckets per octave of load, taken straight from the
+    float's exponent and top mantissa bits, so p99 is good to about 9%.
+    The window being measured belongs to the audio thread alone; the
+    published summary sits behind a sequence lock, which readers retry
+    rather than wait on.
+
+    Switched off, a block costs one relaxed load and one branch. Building
+    with DELAYWAVE_CPU_METER=0 removes the timing altogether.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #define DELAYWAVE_CYCLE_COUNTER_TSC 1
+ #if defined(_MSC_VER)
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+#ifndef DELAYWAVE_CPU_METER
+ #define DELAYWAVE_CPU_METER 1
+#endif
+
+namespace DelayWaveDSP
+{
+    //==============================================================================
+    // The cheapest monotonic counter there is: the time stamp counter on x86,
+    // the generic timer on ARM64, the steady clock elsewhere
+    inline std::uint64_t readCycleCounter() noexcept
+    {
+       #if DELAYWAVE_CYCLE_COUNTER_TSC
+        return __rdtsc();
+       #elif defined(__aarch64__)
+        std::uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+       #else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+       #endif
+    }
+
+    inline const char* getCycleCounterName() noexcept
+    {
+       #if DELAYWAVE_CYCLE_COUNTER_TSC
+        return "rdtsc";
+       #elif defined(__aarch64__)
+        return "cntvct";
+       #else
+        return "steady_clock";
+       #endif
+    }
+
+    // Ticks of readCycleCounter() per second. The time stamp counter's rate
+    // is measured against the steady clock the first time, which spins for
+    // calibrationSeconds; call it from prepare, never the audio thread.
+    inline double getCycleCounterFrequency()
+    {
+       #if DELAYWAVE_CYCLE_COUNTER_TSC
+        static const double frequency = []
+        {
+            constexpr double calibrationSeconds = 0.01;
+            using Clock = std::chrono::steady_clock;
+
+            const auto clockStart = Clock::now();
+            const auto ticksStart = readCycleCounter();
+            auto clockNow = clockStart;
+
+            while (std::chrono::duration<double>(clockNow - clockStart).count() < calibrationSeconds)
+                clockNow = Clock::now();
+
+            const auto ticks = readCycleCounter() - ticksStart;
+            return static_cast<double>(ticks) / std::chrono::duration<double>(clockNow - clockStart).count();
+        }();
+
+        return frequency;
+       #elif defined(__aarch64__)
+        std::uint64_t frequency;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+        return static_cast<double>(frequency);
+       #else
+        using Period = std::chrono::steady_clock::period;
+        return static_cast<double>(Period::den) / static_cast<double>(Period::num);
+       #endif
+    }
+
+    //==============================================================================
+    class CpuLoadMeter
+    {
+    public:
+        static constexpr int bucketsPerOctave = 8;
+        static constexpr int lowestOctave = -12;    // Loads below 1/4096 of the deadline share the first bucket
+        static constexpr int numOctaves = 16;       // Up to 16 times the deadline
+        static constexpr int numBuckets = bucketsPerOctave * numOctaves;
+
+        // One completed window. Loads are fractions of the deadline: 1 used
+        // all of it.
+        struct Snapshot
+        {
+            std::uint32_t window = 0;       // Counts up with every completed window; 0 before the first
+            std::uint32_t numBlocks = 0;
+            std::uint32_t numOverruns = 0;  // Blocks that took longer than their deadline
+            float minLoad = 0.0f;
+            float meanLoad = 0.0f;
+            float p99Load = 0.0f;
+            float maxLoad = 0.0f;
+        };
+
+        //==============================================================================
+        // Not while the audio thread is in begin() or end()
+        void prepare(double sampleRate)
+        {
+            ticksPerSample = sampleRate > 0.0 ? getCycleCounterFrequency() / sampleRate : 0.0;
+            current = {};
+            publish({});
+        }
+
+        // Off by default. Switching it on starts a fresh measurement, and
+        // getSnapshot() is empty until its first window completes.
+        void setEnabled(bool shouldBeEnabled) noexcept
+        {
+            if (shouldBeEnabled)
+                restartRequested.store(true, std::memory_order_release);
+
+            enabled.store(shouldBeEnabled, std::memory_order_relaxed);
+        }
+
+        bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+        //==============================================================================
+        // Audio thread, around the block. begin() returns 0 when switched off,
+        // and end() then ignores the block.
+        std::uint64_t begin() const noexcept
+        {
+           #if DELAYWAVE_CPU_METER
+            if (enabled.load(std::memory_order_relaxed))
+                return readCycleCounter();
+           #endif
+
+            return 0;
+        }
+
+        void end(std::uint64_t startTicks, int numSamples) noexcept
+        {
+           #if DELAYWAVE_CPU_METER
+            if (startTicks == 0 || numSamples <= 0 || ticksPerSample <= 0.0)
+                return;
+
+            const auto elapsedTicks = readCycleCounter() - startTicks;
+
+            if (restartRequested.exchange(false, std::memory_order_acquire))
+            {
+                windowRequested.store(false, std::memory_order_relaxed);
+                current = {};
+                publish({});
+            }
+            else if (windowRequested.exchange(false, std::memory_order_acquire))
+            {
+                publish(current.summarise(completedWindow + 1));
+                current = {};
+            }
+
+            current.add(static_cast<float>(static_cast<double>(elapsedTicks) / (ticksPerSample * numSamples)));
+           #else
+            (void) startTicks;
+            (void) numSamples;
+           #endif
+        }
+
+        //==============================================================================
+        // Any thread. Ends the current window at the end of the audio
+        // thread's next block, which starts the next one; every block lands
+        // in exactly one window.
+        void requestWindow() noexcept { windowRequested.store(true, std::memory_order_release); }
+
+        // Any thread. The last window completed by requestWindow(); the same
+        // one (same window number) until the audio thread completes another.
+        Snapshot getSnapshot() const noexcept
+        {
+            Snapshot snapshot;
+
+            for (;;)
+            {
+                const auto before = sequence.load(std::memory_order_acquire);
+
+                if ((before & 1) == 0)
+                {
+                    snapshot.window = published.window.load(std::memory_order_relaxed);
+                    snapshot.numBlocks = published.numBlocks.load(std::memory_order_relaxed);
+                    snapshot.numOverruns = published.numOverruns.load(std::memory_order_relaxed);
+                    snapshot.minLoad = published.minLoad.load(std::memory_order_relaxed);
+                    snapshot.meanLoad = published.meanLoad.load(std::memory_order_relaxed);
+                    snapshot.p99Load = published.p99Load.load(std::memory_order_relaxed);
+                    snapshot.maxLoad = published.maxLoad.load(std::memory_order_relaxed);
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+
+                    if (sequence.load(std::memory_order_relaxed) == before)
+                        return snapshot;
+                }
+            }
+        }
+
+    private:
+        //==============================================================================
+        // Bits of a float's exponent and top mantissa bits that index the buckets
+        static constexpr int mantissaShift = 23 - 3;
+        static_assert((1 << (23 - mantissaShift)) == bucketsPerOctave, "Buckets are split by the top mantissa bits");
+
+        static constexpr int firstBucketKey = (127 + lowestOctave) * bucketsPerOctave;
+
+        static int getBucket(float load) noexcept
+        {
+            if (! (load > 0.0f))
+                return 0;
+
+            std::uint32_t bits;
+            std::memcpy(&bits, &load, sizeof(bits));
+            return std::clamp(static_cast<int>(bits >> mantissaShift) - firstBucketKey, 0, numBuckets - 1);
+        }
+
+        static float getBucketUpperEdge(int bucket) noexcept
+        {
+            const auto bits = static_cast<std::uint32_t>(bucket + 1 + firstBucketKey) << mantissaShift;
+            float edge;
+            std::memcpy(&edge, &bits, sizeof(edge));
+            return edge;
+        }
+
+        //==============================================================================
+        // The window being measured; only the audio thread touches it
+        struct Window
+        {
+            std::uint32_t numBlocks = 0;
+            std::uint32_t numOverruns = 0;
+            double loadSum = 0.0;
+            float minLoad = 0.0f;
+            float maxLoad = 0.0f;
+            std::array<std::uint32_t, numBuckets> buckets {};
+
+            void add(float load) noexcept
+            {
+                minLoad = numBlocks == 0 ? load : std::min(minLoad, load);
+                maxLoad = numBlocks == 0 ? load : std::max(maxLoad, load);
+                if (load > 1.0f)
+                    ++numOverruns;
+
+                loadSum += load;
+                ++buckets[static_cast<size_t>(getBucket(load))];
+                ++numBlocks;
+            }
+
+            Snapshot summarise(std::uint32_t window) const noexcept
+            {
+                Snapshot snapshot;
+                snapshot.window = window;
+                snapshot.numBlocks = numBlocks;
+
+                if (numBlocks == 0)
+                    return snapshot;
+
+                snapshot.numOverruns = numOverruns;
+                snapshot.minLoad = minLoad;
+                snapshot.maxLoad = maxLoad;
+                snapshot.meanLoad = static_cast<float>(loadSum / numBlocks);
+
+                // The upper edge of the bucket holding the 99th percentile
+                const auto rank = static_cast<std::uint64_t>(numBlocks) * 99;
+                std::uint64_t count = 0;
+                int bucket = 0;
+
+                for (; bucket < numBuckets - 1; ++bucket)
+                {
+                    count += buckets[static_cast<size_t>(bucket)];
+
+                    if (count * 100 >= rank)
+                        break;
+                }
+
+                snapshot.p99Load = std::clamp(getBucketUpperEdge(bucket), minLoad, maxLoad);
+                return snapshot;
+            }
+        };
+
+        // A sequence lock: odd while the audio thread writes the completed
+        // window, so readers retry instead of seeing a torn one
+        void publish(const Snapshot& snapshot) noexcept
+        {
+            const auto before = sequence.load(std::memory_order_relaxed);
+            sequence.store(before + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            published.window.store(snapshot.window, std::memory_order_relaxed);
+            published.numBlocks.store(snapshot.numBlocks, std::memory_order_relaxed);
+            published.numOverruns.store(snapshot.numOverruns, std::memory_order_relaxed);
+            published.minLoad.store(snapshot.minLoad, std::memory_order_relaxed);
+            published.meanLoad.store(snapshot.meanLoad, std::memory_order_relaxed);
+            published.p99Load.store(snapshot.p99Load, std::memory_order_relaxed);
+            published.maxLoad.store(snapshot.maxLoad, std::memory_order_relaxed);
+
+            sequence.store(before + 2, std::memory_order_release);
+            completedWindow = snapshot.window;
+        }
+
+        //==============================================================================
+        double ticksPerSample = 0.0;
+        std::atomic<bool> enabled { false };
+        std::atomic<bool> restartRequested { false };
+        std::atomic<bool> windowRequested { false };
+
+        Window current;
+        std::uint32_t completedWindow = 0;
+
+        std::atomic<std::uint32_t> sequence { 0 };
+        struct
+        {
+            std::atomic<std::uint32_t> window { 0 };
+            std::atomic<std::uint32_t> numBlocks { 0 };
+            std::atomic<std::uint32_t> numOverruns { 0 };
+            std::atomic<float> minLoad { 0.0f };
+            std::atomic<float> meanLoad { 0.0f };
+            std::atomic<float> p99Load { 0.0f };
+            std::atomic<float> maxLoad { 0.0f };
+        } published;
+    };
+}
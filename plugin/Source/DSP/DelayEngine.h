@@ -0,0 +1,706 @@
+/*
+  ==============================================================================
+    DelayWave - Delay Engine
+    Modulated delay core: delay read, Lagrange interpolation, tone filter
+    (ToneFilter.h), optional allpass diffusion (Diffuser.h), saturated
+    feedback write (Saturator.h) and dry/wet mix.
+
+    Optional extra taps read the same ring in the same pass. Each tap has
+    its own time (a fraction of the channel's read position), gain, pan and
+    one-pole filter; they are stored as structure-of-arrays and read four
+    at a time. Taps only feed the wet output, feedback comes from the main
+    read head.
+
+    The feedback write can go through a FeedbackMatrix (ping-pong or a
+    four-line FDN). The SIMD kernel does the mixing as four broadcast
+    multiply-adds per frame; the scalar kernel switches to sample-major
+    order for it, since every lane then depends on every other. What is fed
+    back then goes through the diffuser, whose lanes are independent again.
+
+    All channels share one interleaved DelayLine (one frame = one SIMD
+    vector), so the SIMD kernel handles every channel in a single pass. The
+    ring stores only the lanes the channel count needs (see getRingLanes()),
+    so mono and stereo keep one and two samples per frame.
+    The scalar kernel runs the same maths channel by channel and is kept as
+    the reference implementation for A/B comparisons.
+
+    The kernels are specialised for the channel layout, which is chosen
+    once in prepare(): mono and stereo get fixed channel loops, mono runs
+    on one lane instead of a mostly idle frame, and stereo can run as
+    mid/side with its own feedback for the side channel.
+
+    In jump mode a second read head is faded in while the time changes;
+    the taps follow it through the same fade. When every read position is
+    a whole number of samples the kernels are built with whole-sample
+    reads and skip interpolation.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayLine.h"
+#include "DelayParams.h"
+#include "Diffuser.h"
+#include "FeedbackMatrix.h"
+#include "Saturator.h"
+#include "ToneFilter.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace DelayWaveDSP
+{
+inline namespace DELAYWAVE_ISA
+{
+    //==============================================================================
+    // SampleType is float or double; both run the same kernels, with
+    // Vec4<SampleType> as the SIMD frame.
+    template <typename SampleType = float, typename Interp = Interpolation::Lagrange3>
+    class DelayEngine
+    {
+    public:
+        static constexpr int maxChannels = DelayBlockParams::numLanes;
+        static constexpr int maxTaps = TapLayout::maxTaps;
+
+        static_assert(maxChannels == Vec4<SampleType>::size, "One engine processes one SIMD frame of channels");
+
+        //==============================================================================
+        void prepare(int maxDelaySamplesToUse, int numChannelsToUse, double sampleRate)
+        {
+            numChannels = std::clamp(numChannelsToUse, 1, maxChannels);
+            layout = defaultLayout();
+            delayLine.prepare(maxDelaySamplesToUse, getRingLanes(numChannels));
+            toneFilter.prepare(sampleRate);
+            diffuser.prepare(sampleRate);
+            reset();
+        }
+
+        void reset()
+        {
+            delayLine.reset();
+            toneFilter.reset();
+            diffuser.reset();
+            saturator.reset();
+            writePeak = 0;
+
+            for (auto& state : tapState)
+                std::fill(std::begin(state), std::end(state), SampleType(0));
+        }
+
+        // Updates the extra taps; cheap enough to call once per block. Pan
+        // is a balance between even (left) and odd (right) channels, and is
+        // ignored for mono.
+        void setTaps(const TapLayout& newTaps) noexcept
+        {
+            // Stateful interpolators cannot serve extra read heads
+            const int requested = Interp::hasState ? 0 : std::clamp(newTaps.numTaps, 0, maxTaps);
+
+            // Removed taps restart from silence if they come back
+            for (int t = requested; t < numTaps; ++t)
+                for (auto& state : tapState)
+                    state[t] = SampleType(0);
+
+            numTaps = requested;
+            numTapGroups = (numTaps + tapGroupSize - 1) / tapGroupSize;
+
+            // Padding taps in the last group are silent
+            for (int t = 0; t < maxTaps; ++t)
+            {
+                const bool active = t < numTaps;
+                const float pan = std::clamp(newTaps.pan[t], -1.0f, 1.0f);
+
+                tapTime[t] = static_cast<SampleType>(active ? std::clamp(newTaps.time[t], 0.0f, 1.0f) : 1.0f);
+                tapCoeff[t] = static_cast<SampleType>(active ? std::clamp(newTaps.filterCoeff[t], 0.0f, 1.0f) : 0.0f);
+
+                for (int ch = 0; ch < maxChannels; ++ch)
+                {
+                    const float balance = numChannels < 2 ? 1.0f
+                                        : (ch & 1) == 0 ? std::min(1.0f, 1.0f - pan)
+                                                        : std::min(1.0f, 1.0f + pan);
+
+                    tapGain[ch][t] = static_cast<SampleType>(active ? newTaps.gain[t] * balance : 0.0f);
+                }
+            }
+        }
+
+        int getNumTaps() const noexcept { return numTaps; }
+
+        // Sets the feedback mixing between lanes; identity disables it
+        void setFeedbackMatrix(const FeedbackMatrix& requested) noexcept
+        {
+            const auto matrix = requested.needsStereoPair && numChannels < 2 ? FeedbackMatrix::identity() : requested;
+            crossFeedback = ! matrix.isIdentity();
+
+            for (int lane = 0; lane < maxChannels; ++lane)
+            {
+                laneDelayScale[lane] = matrix.laneDelayScale[lane];
+
+                for (int from = 0; from < maxChannels; ++from)
+                {
+                    feedbackRows[lane][from] = matrix.gains[lane][from];
+                    feedbackColumns[from][lane] = matrix.gains[lane][from];
+                }
+            }
+        }
+
+        bool hasCrossFeedback() const noexcept { return crossFeedback; }
+
+        // Runs a stereo engine as mid/side; ignored for other channel counts.
+        // Read positions and feedback for channel 1 then apply to the side.
+        void setMidSide(bool shouldUseMidSide) noexcept
+        {
+            layout = shouldUseMidSide && numChannels == 2 ? ChannelLayout::MidSide : defaultLayout();
+        }
+
+        ChannelLayout getLayout() const noexcept { return layout; }
+
+        void release()
+        {
+            delayLine.release();
+            diffuser.release();
+        }
+
+        int getMaximumDelayInSamples() const noexcept { return delayLine.getMaximumDelayInSamples(); }
+        size_t getMemoryUsageBytes() const noexcept { return delayLine.getMemoryUsageBytes() + diffuser.getMemoryUsageBytes(); }
+        int getNumChannels() const noexcept { return numChannels; }
+
+        // Largest magnitude written into the ring by the last process() call,
+        // over every lane. Once this has stayed below a threshold for the
+        // whole ring length, nothing louder is left to read back.
+        SampleType getWritePeak() const noexcept { return writePeak; }
+
+        //==============================================================================
+        // Processes numSamples in place. Both modes give the same result for
+        // the same block of audio. When feedback and mix are constant and the
+        // tone filter is not gliding, the steady-state variant of the kernel
+        // is used.
+        void process(SampleType* const* channels, int numChannelsToProcess, int numSamples,
+                     const DelayBlockParams& params, KernelMode mode) noexcept
+        {
+            const int n = std::min(numChannelsToProcess, numChannels);
+            toneFilter.setTarget(params.tone, numSamples);
+            diffuser.setTarget(params.diffusion, numSamples);
+            saturator.setSettings(params.saturation);
+
+            // Stateful interpolators cannot serve a second read head
+            jumping = ! Interp::hasState && params.jumpDelaySamples[0] != nullptr;
+
+            // The fixed layouts need every prepared channel
+            const auto active = n == numChannels ? layout : ChannelLayout::Discrete;
+            const bool constant = params.feedback.isConstant() && params.mix.isConstant() && ! toneFilter.isRamping()
+                                  && (active != ChannelLayout::MidSide || params.sideFeedback.isConstant());
+
+            switch (active)
+            {
+                case ChannelLayout::Mono:     processWithLayout<ChannelLayout::Mono>(channels, n, numSamples, params, mode, constant); break;
+                case ChannelLayout::Stereo:   processWithLayout<ChannelLayout::Stereo>(channels, n, numSamples, params, mode, constant); break;
+                case ChannelLayout::MidSide:  processWithLayout<ChannelLayout::MidSide>(channels, n, numSamples, params, mode, constant); break;
+                case ChannelLayout::Discrete: processWithLayout<ChannelLayout::Discrete>(channels, n, numSamples, params, mode, constant); break;
+            }
+
+            if (diffuser.isActive())
+                diffuser.advance(numSamples);
+        }
+
+    private:
+        //==============================================================================
+        ChannelLayout defaultLayout() const noexcept
+        {
+            return numChannels == 1 ? ChannelLayout::Mono
+                 : numChannels == 2 ? ChannelLayout::Stereo
+                                    : ChannelLayout::Discrete;
+        }
+
+        // Channel count known at compile time for the fixed layouts
+        template <ChannelLayout Layout>
+        static int activeChannels(int n) noexcept
+        {
+            if constexpr (Layout == ChannelLayout::Mono)
+                return 1;
+            else if constexpr (Layout == ChannelLayout::Stereo || Layout == ChannelLayout::MidSide)
+                return 2;
+            else
+                return n;
+        }
+
+        template <ChannelLayout Layout>
+        void processWithLayout(SampleType* const* channels, int n, int numSamples, const DelayBlockParams& params,
+                               KernelMode mode, bool constant) noexcept
+        {
+            const int active = activeChannels<Layout>(n);
+
+            if (crossFeedback)
+            {
+                if (params.wholeSampleDelays) processWithMode<true, true, Layout>(channels, active, numSamples, params, mode, constant);
+                else                          processWithMode<true, false, Layout>(channels, active, numSamples, params, mode, constant);
+            }
+            else
+            {
+                if (params.wholeSampleDelays) processWithMode<false, true, Layout>(channels, active, numSamples, params, mode, constant);
+                else                          processWithMode<false, false, Layout>(channels, active, numSamples, params, mode, constant);
+            }
+        }
+
+        template <bool Cross, bool Whole, ChannelLayout Layout>
+        void processWithMode(SampleType* const* channels, int n, int numSamples, const DelayBlockParams& params,
+                             KernelMode mode, bool constant) noexcept
+        {
+            // Without cross-feedback a mono frame would carry three idle
+            // lanes, so mono always takes the one-lane kernel
+            constexpr bool singleLane = Layout == ChannelLayout::Mono && ! Cross;
+
+            if (mode == KernelMode::Simd && ! singleLane)
+            {
+                if (constant) processSimd<true, Cross, Whole, Layout>(channels, n, numSamples, params);
+                else          processSimd<false, Cross, Whole, Layout>(channels, n, numSamples, params);
+            }
+            else if constexpr (Cross)
+            {
+                if (constant) processScalarCross<true, Whole, Layout>(channels, n, numSamples, params);
+                else          processScalarCross<false, Whole, Layout>(channels, n, numSamples, params);
+            }
+            else
+            {
+                if (constant) processScalar<true, Whole, Layout>(channels, n, numSamples, params);
+                else          processScalar<false, Whole, Layout>(channels, n, numSamples, params);
+            }
+        }
+
+        // Feedback of one lane; in mid/side the side lane has its own
+        template <ChannelLayout Layout>
+        static const ControlSignal& laneFeedback(const DelayBlockParams& params, int lane) noexcept
+        {
+            if constexpr (Layout == ChannelLayout::MidSide)
+                return lane == 1 ? params.sideFeedback : params.feedback;
+            else
+                return params.feedback;
+        }
+
+        // In-place conversion of a stereo block for the scalar kernels, with
+        // the same arithmetic as the per-frame conversion in the SIMD kernel
+        static void encodeMidSide(SampleType* const* channels, int numSamples) noexcept
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const SampleType l = channels[0][i], r = channels[1][i];
+                channels[0][i] = (l + r) * SampleType(0.5);
+                channels[1][i] = (l - r) * SampleType(0.5);
+            }
+        }
+
+        static void decodeMidSide(SampleType* const* channels, int numSamples) noexcept
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const SampleType m = channels[0][i], side = channels[1][i];
+                channels[0][i] = m + side;
+                channels[1][i] = m - side;
+            }
+        }
+
+        // Read position of a lane at sample i, from delaySamples or
+        // jumpDelaySamples. Without cross-feedback the unused lanes only run
+        // on silence, so they just follow channel 0.
+        template <bool Cross>
+        SampleType laneDelay(const float* const* positions, int lane, int numActive, int i) const noexcept
+        {
+            if (lane < numActive)
+                return positions[lane][i];
+
+            if constexpr (Cross)
+                return positions[lane % numActive][i] * laneDelayScale[lane];
+            else
+                return positions[0][i];
+        }
+
+        //==============================================================================
+        // Where one lane reads at one sample. While jumping, every read is
+        // faded from delay to jumpDelay.
+        struct ReadPosition
+        {
+            SampleType delay;
+            SampleType jumpDelay;
+            SampleType fade;
+        };
+
+        ReadPosition readPosition(const float* delay, const float* jumpDelay, const ControlSignal& fade, int i) const noexcept
+        {
+            if (! jumping)
+                return { delay[i], SampleType(0), SampleType(0) };
+
+            return { delay[i], jumpDelay[i], static_cast<SampleType>(fade[i]) };
+        }
+
+        template <bool Whole>
+        SampleType readLane(int lane, SampleType delay, int position) noexcept
+        {
+            if constexpr (Whole)
+                return delayLine.readWhole(lane, delay, position);
+            else
+                return delayLine.read(lane, delay, position);
+        }
+
+        // Single read at a lane's position, scaled by timeScale (taps)
+        template <bool Whole>
+        SampleType readScalar(int lane, const ReadPosition& read, SampleType timeScale, int position) noexcept
+        {
+            const SampleType delayed = readLane<Whole>(lane, timeScale * read.delay, position);
+
+            if (! jumping)
+                return delayed;
+
+            return delayed + read.fade * (readLane<Whole>(lane, timeScale * read.jumpDelay, position) - delayed);
+        }
+
+        //==============================================================================
+        // Reads control i, folding to the block constant when Constant is set.
+        // Otherwise only some of the controls may be ramping, so each one
+        // still checks for its own ramp.
+        template <bool Constant>
+        static SampleType control(const ControlSignal& signal, int i) noexcept
+        {
+            if constexpr (Constant)
+                return static_cast<SampleType>(signal.value);
+            else
+                return static_cast<SampleType>(signal[i]);
+        }
+
+        //==============================================================================
+        template <bool Constant, bool Whole, ChannelLayout Layout>
+        void processScalar(SampleType* const* channels, int numActive, int numSamples, const DelayBlockParams& params) noexcept
+        {
+            const int writePos = delayLine.getWritePosition();
+            const bool diffusing = diffuser.isActive();
+            SampleType peak = 0;
+
+            if constexpr (Layout == ChannelLayout::MidSide)
+                encodeMidSide(channels, numSamples);
+
+            for (int ch = 0; ch < numActive; ++ch)
+            {
+                auto* data = channels[ch];
+                const auto* delay = params.delaySamples[ch];
+                const auto* jumpDelay = params.jumpDelaySamples[ch];
+                const auto& feedback = laneFeedback<Layout>(params, ch);
+                SampleType filterState[ToneFilter<SampleType>::numStateSlots];
+                SampleType saturatorState[Saturator<SampleType>::numStateSlots];
+                toneFilter.loadState(filterState, ch);
+                saturator.loadState(saturatorState, ch);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const auto read = readPosition(delay, jumpDelay, params.jumpFade, i);
+                    const SampleType delayed = readScalar<Whole>(ch, read, SampleType(1), writePos + i);
+                    const SampleType taps = numTaps > 0 ? readTapsScalar<Whole>(ch, read, writePos + i) : SampleType(0);
+
+                    const SampleType wet = toneFilter.template process<SampleType, ! Constant>(delayed, filterState, i);
+
+                    const SampleType dry = data[i];
+                    const SampleType mix = control<Constant>(params.mix, i);
+                    const SampleType fed = diffusing ? diffuser.processLane(ch, wet, i) : wet;
+                    const SampleType record = saturator.process(dry + fed * control<Constant>(feedback, i), saturatorState);
+                    delayLine.write(ch, record, writePos + i);
+                    peak = std::max(peak, std::abs(record));
+                    data[i] = dry * (SampleType(1) - mix) + (wet + taps) * mix;
+                }
+
+                toneFilter.storeState(filterState, ch);
+                saturator.storeState(saturatorState, ch);
+            }
+
+            if constexpr (Layout == ChannelLayout::MidSide)
+                decodeMidSide(channels, numSamples);
+
+            writePeak = peak;
+            delayLine.advance(numSamples);
+        }
+
+        //==============================================================================
+        // Scalar reference with a feedback matrix: all lanes run, one sample
+        // at a time, and unused lanes take part in the network on silence
+        template <bool Constant, bool Whole, ChannelLayout Layout>
+        void processScalarCross(SampleType* const* channels, int numActive, int numSamples, const DelayBlockParams& params) noexcept
+        {
+            const int writePos = delayLine.getWritePosition();
+            const bool diffusing = diffuser.isActive();
+            SampleType peak = 0;
+
+            if constexpr (Layout == ChannelLayout::MidSide)
+                encodeMidSide(channels, numSamples);
+
+            SampleType filterState[maxChannels][ToneFilter<SampleType>::numStateSlots];
+            SampleType saturatorState[maxChannels][Saturator<SampleType>::numStateSlots];
+            for (int lane = 0; lane < maxChannels; ++lane)
+            {
+                toneFilter.loadState(filterState[lane], lane);
+                saturator.loadState(saturatorState[lane], lane);
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                SampleType wet[maxChannels];
+                const SampleType mix = control<Constant>(params.mix, i);
+                SampleType taps[maxChannels] = {};
+
+                for (int lane = 0; lane < maxChannels; ++lane)
+                {
+                    ReadPosition read { laneDelay<true>(params.delaySamples, lane, numActive, i), SampleType(0), SampleType(0) };
+                    if (jumping)
+                    {
+                        read.jumpDelay = laneDelay<true>(params.jumpDelaySamples, lane, numActive, i);
+                        read.fade = static_cast<SampleType>(params.jumpFade[i]);
+                    }
+
+                    const SampleType delayed = readScalar<Whole>(lane, read, SampleType(1), writePos + i);
+
+                    if (lane < numActive && numTaps > 0)
+                        taps[lane] = readTapsScalar<Whole>(lane, read, writePos + i);
+
+                    wet[lane] = toneFilter.template process<SampleType, ! Constant>(delayed, filterState[lane], i);
+                }
+
+                for (int lane = 0; lane < maxChannels; ++lane)
+                {
+                    const SampleType* row = feedbackRows[lane];
+                    SampleType mixed = ((row[0] * wet[0] + row[1] * wet[1])
+                                        + row[2] * wet[2]) + row[3] * wet[3];
+
+                    if (diffusing)
+                        mixed = diffuser.processLane(lane, mixed, i);
+
+                    const SampleType dry = lane < numActive ? channels[lane][i] : SampleType(0);
+                    const SampleType feedback = control<Constant>(laneFeedback<Layout>(params, lane), i);
+                    const SampleType record = saturator.process(dry + mixed * feedback, saturatorState[lane]);
+                    delayLine.write(lane, record, writePos + i);
+                    peak = std::max(peak, std::abs(record));
+
+                    if (lane < numActive)
+                        channels[lane][i] = dry * (SampleType(1) - mix) + (wet[lane] + taps[lane]) * mix;
+                }
+            }
+
+            for (int lane = 0; lane < maxChannels; ++lane)
+            {
+                toneFilter.storeState(filterState[lane], lane);
+                saturator.storeState(saturatorState[lane], lane);
+            }
+
+            if constexpr (Layout == ChannelLayout::MidSide)
+                decodeMidSide(channels, numSamples);
+
+            writePeak = peak;
+            delayLine.advance(numSamples);
+        }
+
+        //==============================================================================
+        template <bool Constant, bool Cross, bool Whole, ChannelLayout Layout>
+        void processSimd(SampleType* const* channels, int numActive, int numSamples, const DelayBlockParams& params) noexcept
+        {
+            using V = Vec4<SampleType>;
+
+            // Unused lanes run on silence; they only matter with cross-feedback
+            V columns[maxChannels];
+            for (int from = 0; from < maxChannels; ++from)
+                columns[from] = V::load(feedbackColumns[from]);
+
+            V filterState[ToneFilter<SampleType>::numStateSlots];
+            V saturatorState[Saturator<SampleType>::numStateSlots];
+            toneFilter.loadState(filterState);
+            saturator.loadState(saturatorState);
+            V peak(SampleType(0));
+            const bool diffusing = diffuser.isActive();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                SampleType delays[maxChannels];
+                for (int lane = 0; lane < maxChannels; ++lane)
+                    delays[lane] = laneDelay<Cross>(params.delaySamples, lane, numActive, i);
+
+                V delayed = readFrame<V, Whole>(delays);
+
+                SampleType jumpDelays[maxChannels] = {};
+                const SampleType fade = jumping ? static_cast<SampleType>(params.jumpFade[i]) : SampleType(0);
+                if (jumping)
+                {
+                    for (int lane = 0; lane < maxChannels; ++lane)
+                        jumpDelays[lane] = laneDelay<Cross>(params.jumpDelaySamples, lane, numActive, i);
+
+                    delayed = delayed + V(fade) * (readFrame<V, Whole>(jumpDelays) - delayed);
+                }
+
+                SampleType tapOut[maxChannels] = {};
+                if (numTaps > 0)
+                    for (int ch = 0; ch < numActive; ++ch)
+                        tapOut[ch] = readTapsSimd<Whole>(ch, { delays[ch], jumpDelays[ch], fade }, delayLine.getWritePosition());
+
+                const V wet = toneFilter.template process<V, ! Constant>(delayed, filterState, i);
+
+                SampleType dryIn[maxChannels] = {};
+                if constexpr (Layout == ChannelLayout::MidSide)
+                {
+                    const SampleType l = channels[0][i], r = channels[1][i];
+                    dryIn[0] = (l + r) * SampleType(0.5);
+                    dryIn[1] = (l - r) * SampleType(0.5);
+                }
+                else
+                {
+                    for (int ch = 0; ch < numActive; ++ch)
+                        dryIn[ch] = channels[ch][i];
+                }
+
+                const V dry = V::load(dryIn);
+                const V mix(control<Constant>(params.mix, i));
+                const SampleType fb = control<Constant>(params.feedback, i);
+                const V feedback = Layout == ChannelLayout::MidSide
+                                 ? V::fromValues(fb, control<Constant>(params.sideFeedback, i), fb, fb)
+                                 : V(fb);
+
+                V fed = wet;
+                if constexpr (Cross)
+                {
+                    SampleType s[maxChannels];
+                    wet.store(s);
+                    fed = ((columns[0] * V(s[0]) + columns[1] * V(s[1]))
+                           + columns[2] * V(s[2])) + columns[3] * V(s[3]);
+                }
+
+                if (diffusing)
+                    fed = diffuser.processFrame(fed, i);
+
+                const V record = saturator.process(dry + fed * feedback, saturatorState);
+
+                delayLine.writeFrame(record);
+                peak = V::max(peak, V::abs(record));
+
+                SampleType out[maxChannels];
+                (dry * (V(SampleType(1)) - mix) + (wet + V::load(tapOut)) * mix).store(out);
+
+                if constexpr (Layout == ChannelLayout::MidSide)
+                {
+                    channels[0][i] = out[0] + out[1];
+                    channels[1][i] = out[0] - out[1];
+                }
+                else
+                {
+                    for (int ch = 0; ch < numActive; ++ch)
+                        channels[ch][i] = out[ch];
+                }
+
+                delayLine.advance();
+            }
+
+            toneFilter.storeState(filterState);
+            saturator.storeState(saturatorState);
+
+            SampleType lanePeaks[maxChannels];
+            peak.store(lanePeaks);
+            writePeak = std::max(std::max(lanePeaks[0], lanePeaks[1]), std::max(lanePeaks[2], lanePeaks[3]));
+        }
+
+        //==============================================================================
+        // Filtered and weighted sum of one channel's extra taps. Both versions
+        // accumulate per group lane and sum the lanes in the same order, so
+        // the scalar and SIMD kernels stay identical.
+        template <bool Whole>
+        SampleType readTapsScalar(int ch, const ReadPosition& read, int position) noexcept
+        {
+            SampleType partial[tapGroupSize] = {};
+
+            for (int t = 0; t < numTapGroups * tapGroupSize; ++t)
+            {
+                SampleType& state = tapState[ch][t];
+                state = state + tapCoeff[t] * (readScalar<Whole>(ch, read, tapTime[t], position) - state);
+                partial[t % tapGroupSize] = partial[t % tapGroupSize] + state * tapGain[ch][t];
+            }
+
+            return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+        }
+
+        template <bool Whole>
+        SampleType readTapsSimd(int ch, const ReadPosition& read, int position) noexcept
+        {
+            if constexpr (Interp::hasState)
+            {
+                // setTaps() keeps numTaps at zero for these
+                (void) ch; (void) read; (void) position;
+                return SampleType(0);
+            }
+            else
+            {
+                using V = Vec4<SampleType>;
+                V sum(SampleType(0));
+
+                for (int g = 0; g < numTapGroups; ++g)
+                {
+                    const int first = g * tapGroupSize;
+
+                    const V time = V::load(tapTime + first);
+                    SampleType delays[tapGroupSize];
+                    (time * V(read.delay)).store(delays);
+
+                    V delayed = readTaps<V, Whole>(ch, delays, position);
+
+                    if (jumping)
+                    {
+                        (time * V(read.jumpDelay)).store(delays);
+                        delayed = delayed + V(read.fade) * (readTaps<V, Whole>(ch, delays, position) - delayed);
+                    }
+                    V state = V::load(tapState[ch] + first);
+                    state = state + V::load(tapCoeff + first) * (delayed - state);
+                    state.store(tapState[ch] + first);
+
+                    sum = sum + state * V::load(tapGain[ch] + first);
+                }
+
+                SampleType partial[tapGroupSize];
+                sum.store(partial);
+                return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+            }
+        }
+
+        template <typename V, bool Whole>
+        V readFrame(const SampleType* delays) noexcept
+        {
+            if constexpr (Whole)
+                return delayLine.template readFrameWhole<V>(delays);
+            else
+                return delayLine.template readFrame<V>(delays);
+        }
+
+        template <typename V, bool Whole>
+        V readTaps(int ch, const SampleType* delays, int position) noexcept
+        {
+            if constexpr (Whole)
+                return delayLine.template readTapsWhole<V>(ch, delays, position);
+            else
+                return delayLine.template readTaps<V>(ch, delays, position);
+        }
+
+        //==============================================================================
+        DelayLine<SampleType, maxChannels, Interp> delayLine;
+        bool jumping = false;           // A second read head is fading in this block
+        int numChannels = 0;
+        ChannelLayout layout = ChannelLayout::Discrete;
+
+        ToneFilter<SampleType> toneFilter;
+        Diffuser<SampleType> diffuser;
+        Saturator<SampleType> saturator;
+        SampleType writePeak = 0;
+
+        // Feedback matrix, stored both ways round for the two kernels
+        bool crossFeedback = false;
+        SampleType feedbackRows[maxChannels][maxChannels] {};
+        SampleType feedbackColumns[maxChannels][maxChannels] {};
+        SampleType laneDelayScale[maxChannels] { 1, 1, 1, 1 };
+
+        // Extra taps, structure-of-arrays in groups of four
+        static constexpr int tapGroupSize = maxChannels;    // One SIMD frame
+        int numTaps = 0;
+        int numTapGroups = 0;
+        SampleType tapTime[maxTaps] {};
+        SampleType tapCoeff[maxTaps] {};
+        SampleType tapGain[maxChannels][maxTaps] {};
+        SampleType tapState[maxChannels][maxTaps] {};
+    };
+}
+}
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+    DelayWave - Delay Kernels
+    The delay engine, built once per instruction set. beatconnect_configure_plugin
+    (SIMD_DISPATCH_SOURCE) generates one small source per variant that
+    defines BEATCONNECT_SIMD_ISA and includes this file; compiled on its own
+    it is the baseline variant.
+
+    Everything shared with the rest of the plugin is included first, so the
+    standard library and the plain data types are compiled for the
+    baseline. Only the kernel headers after the target switch are built
+    for the variant, and they sit in the variant's own namespace. With
+    GCC and Clang the switch is a target attribute on those functions;
+    MSVC needs none for the intrinsics, so there only the explicit AVX
+    code differs.
+  ==============================================================================
+*/
+
+#include "DelayProcessor.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#if DELAYWAVE_X86
+ #include <immintrin.h>     // Before the target switch, the intrinsics set their own targets
+#endif
+
+#if defined(BEATCONNECT_SIMD_AVX2) || defined(BEATCONNECT_SIMD_AVX512)
+ // x86 variants compile to nothing in builds for other architectures,
+ // such as the arm64 half of a universal binary
+ #define DELAYWAVE_KERNELS_ENABLED DELAYWAVE_X86
+#else
+ #define DELAYWAVE_KERNELS_ENABLED 1
+#endif
+
+#if DELAYWAVE_KERNELS_ENABLED
+
+// AVX-512 brings FMA with it. Contraction stays off so every variant
+// rounds exactly like the baseline and switching CPUs never changes the
+// output.
+#if defined(BEATCONNECT_SIMD_AVX512)
+ #if defined(__clang__)
+  #pragma clang attribute push (__attribute__((target("avx2,avx512f,avx512dq,avx512bw,avx512vl"))), apply_to = function)
+  #pragma clang fp contract(off)
+ #elif defined(__GNUC__)
+  #pragma GCC push_options
+  #pragma GCC target("avx2,avx512f,avx512dq,avx512bw,avx512vl")
+  #pragma GCC optimize("fp-contract=off")
+ #endif
+#elif defined(BEATCONNECT_SIMD_AVX2)
+ #if defined(__clang__)
+  #pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+ #elif defined(__GNUC__)
+  #pragma GCC push_options
+  #pragma GCC target("avx2")
+ #endif
+#endif
+
+#include "MultichannelDelay.h"
+
+namespace DelayWaveDSP
+{
+inline namespace DELAYWAVE_ISA
+{
+    template <typename SampleType>
+    class DelayProcessorVariant final : public DelayProcessor<SampleType>
+    {
+    public:
+        static_assert(MultichannelDelay<SampleType>::maxChannels == DelayProcessor<SampleType>::maxChannels);
+
+        void prepare(int maxDelaySamples, int numChannels, double sampleRate) override
+        {
+            delay.prepare(maxDelaySamples, numChannels, sampleRate);
+        }
+
+        void reset() override   { delay.reset(); }
+        void release() override { delay.release(); }
+
+        void setTaps(const TapLayout& layout) noexcept override                            { delay.setTaps(layout); }
+        void setFeedbackMatrix(int group, const FeedbackMatrix& matrix) noexcept override  { delay.setFeedbackMatrix(group, matrix); }
+        void setMidSide(bool shouldUseMidSide) noexcept override                           { delay.setMidSide(shouldUseMidSide); }
+
+        int getNumChannels() const noexcept override            { return delay.getNumChannels(); }
+        size_t getMemoryUsageBytes() const noexcept override    { return delay.getMemoryUsageBytes(); }
+        SampleType getWritePeak() const noexcept override       { return delay.getWritePeak(); }
+
+        void process(SampleType* const* channels, int numChannels, int numSamples,
+                     const DelayBlockParams& params, const float* const* delaySamples,
+                     const float* const* jumpDelaySamples, KernelMode mode) noexcept override
+        {
+            delay.process(channels, numChannels, numSamples, params, delaySamples, jumpDelaySamples, mode);
+        }
+
+        InstructionSet getInstructionSet() const noexcept override { return InstructionSet::DELAYWAVE_ISA; }
+
+    private:
+        MultichannelDelay<SampleType> delay;
+    };
+}
+
+    template <>
+    std::unique_ptr<DelayProcessor<float>> createDelayProcessorFor<InstructionSet::DELAYWAVE_ISA, float>()
+    {
+        return std::make_unique<DelayProcessorVariant<float>>();
+    }
+
+    template <>
+    std::unique_ptr<DelayProcessor<double>> createDelayProcessorFor<InstructionSet::DELAYWAVE_ISA, double>()
+    {
+        return std::make_unique<DelayProcessorVariant<double>>();
+    }
+}
+
+#if defined(BEATCONNECT_SIMD_AVX2) || defined(BEATCONNECT_SIMD_AVX512)
+ #if defined(__clang__)
+  #pragma clang attribute pop
+ #elif defined(__GNUC__)
+  #pragma GCC pop_options
+ #endif
+#endif
+
+#endif
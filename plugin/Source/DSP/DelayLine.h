@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+    DelayWave - Delay Line
+    Multichannel ring buffer for modulated reads. The size is a power of two
+    so wraparound is a single mask, and lanes are interleaved so one frame
+    (all lanes at one sample position) can be loaded as a SIMD vector.
+
+    The ring only stores as many lanes as prepare() asks for, so mono and
+    stereo do not pay for a full frame. Frame reads fill the lanes past
+    those with silence, and writes to them are dropped.
+
+    The interpolation policy is a template parameter (see Interpolators.h),
+    so the tap count and maths are fixed at compile time and the read path
+    has no branches beyond the delay clamp. The whole-sample reads skip
+    the interpolator altogether, for read positions that never fall
+    between samples.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Interpolators.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace DelayWaveDSP
+{
+inline namespace DELAYWAVE_ISA
+{
+    template <typename SampleType, int NumLanes, typename Interp = Interpolation::Lagrange3>
+    class DelayLine
+    {
+    public:
+        using Interpolator = Interp;
+        static constexpr int numLanes = NumLanes;
+        static constexpr auto numLaneSlots = static_cast<size_t>(NumLanes);   // Array bound for one value per lane
+
+        // The nearest tap must be at least one sample old, since reads
+        // happen before the current sample is written
+        static constexpr int minDelaySamples = Interp::tapsBefore + 1;
+
+        //==============================================================================
+        // Allocates only when the ring has to grow; preparing again for the
+        // same or a shorter delay, or for fewer lanes, keeps the existing
+        // memory. lanesToStore is 1 to NumLanes.
+        void prepare(int maxDelaySamplesToUse, int lanesToStore = NumLanes)
+        {
+            Interp::initialise();
+            maxDelaySamples = std::max(maxDelaySamplesToUse, minDelaySamples);
+
+            // Room for the taps beyond the longest delay
+            const int required = maxDelaySamples + Interp::numTaps - Interp::tapsBefore;
+            const int newLanes = std::clamp(lanesToStore, 1, NumLanes);
+
+            if (required > size || newLanes != storedLanes)
+            {
+                int newSize = std::max(size, 1);
+                while (newSize < required)
+                    newSize <<= 1;
+
+                buffer.assign(static_cast<size_t>(newSize * newLanes), SampleType(0));
+                size = newSize;
+                mask = size - 1;
+                storedLanes = newLanes;
+            }
+
+            reset();
+        }
+
+        // Frees the ring; the next prepare() allocates again
+        void release()
+        {
+            std::vector<SampleType>().swap(buffer);
+            size = mask = writePos = 0;
+            storedLanes = NumLanes;
+        }
+
+        void reset()
+        {
+            std::fill(buffer.begin(), buffer.end(), SampleType(0));
+            std::fill(std::begin(interpolatorState), std::end(interpolatorState), SampleType(0));
+            writePos = 0;
+        }
+
+        int getMaximumDelayInSamples() const noexcept { return maxDelaySamples; }
+        int getNumStoredLanes() const noexcept { return storedLanes; }
+        int getWritePosition() const noexcept { return writePos; }
+        size_t getMemoryUsageBytes() const noexcept { return buffer.capacity() * sizeof(SampleType); }
+
+        //==============================================================================
+        // Single-lane access at an explicit frame position, for kernels that
+        // walk one channel at a time. position is usually getWritePosition()
+        // plus the sample index within the block.
+        SampleType read(int lane, SampleType delay, int position) noexcept
+        {
+            if (lane >= storedLanes)
+                return SampleType(0);
+
+            int base;
+            SampleType frac;
+            locate(delay, position, base, frac);
+
+            SampleType taps[Interp::numTaps];
+            for (int k = 0; k < Interp::numTaps; ++k)
+                taps[k] = buffer[static_cast<size_t>(((base - k) & mask) * storedLanes + lane)];
+
+            return Interp::interpolate(taps, frac, interpolatorState[lane]);
+        }
+
+        // Whole-sample read: the delay is truncated and no interpolation is
+        // done, so callers pass whole numbers of samples
+        SampleType readWhole(int lane, SampleType delay, int position) noexcept
+        {
+            if (lane >= storedLanes)
+                return SampleType(0);
+
+            return buffer[static_cast<size_t>((locateWhole(delay, position) & mask) * storedLanes + lane)];
+        }
+
+        void write(int lane, SampleType value, int position) noexcept
+        {
+            if (lane < storedLanes)
+                buffer[static_cast<size_t>((position & mask) * storedLanes + lane)] = value;
+        }
+
+        //==============================================================================
+        // Whole-frame access at the write position. V is a vector type with
+        // NumLanes lanes; each lane reads at its own delay.
+        template <typename V>
+        V readFrame(const SampleType* delays) noexcept
+        {
+            static_assert(LaneCount<V>::value == NumLanes, "Vector width must match the lane count");
+
+            int base[numLaneSlots];
+            SampleType frac[numLaneSlots];
+            for (int lane = 0; lane < NumLanes; ++lane)
+                locate(delays[lane], writePos, base[lane], frac[lane]);
+
+            V taps[Interp::numTaps];
+            SampleType values[numLaneSlots] {};
+            for (int k = 0; k < Interp::numTaps; ++k)
+            {
+                for (int lane = 0; lane < storedLanes; ++lane)
+                    values[lane] = buffer[static_cast<size_t>(((base[lane] - k) & mask) * storedLanes + lane)];
+
+                taps[k] = V::load(values);
+            }
+
+            V state = Interp::hasState ? V::load(interpolatorState) : V(SampleType(0));
+            const V result = Interp::interpolate(taps, V::load(frac), state);
+
+            if constexpr (Interp::hasState)
+                state.store(interpolatorState);
+
+            return result;
+        }
+
+        template <typename V>
+        V readFrameWhole(const SampleType* delays) noexcept
+        {
+            static_assert(LaneCount<V>::value == NumLanes, "Vector width must match the lane count");
+
+            SampleType values[numLaneSlots] {};
+            for (int lane = 0; lane < storedLanes; ++lane)
+                values[lane] = buffer[static_cast<size_t>((locateWhole(delays[lane], writePos) & mask) * storedLanes + lane)];
+
+            return V::load(values);
+        }
+
+        // Several reads of one lane in a single call, one delay per vector
+        // lane (multi-tap). Stateful interpolators keep one history per lane
+        // and cannot serve more than one read head.
+        template <typename V>
+        V readTaps(int lane, const SampleType* delays, int position) noexcept
+        {
+            static_assert(! Interp::hasState, "Multi-tap reads need a stateless interpolator");
+            constexpr int numReads = LaneCount<V>::value;
+            constexpr auto numReadSlots = static_cast<size_t>(numReads);
+
+            if (lane >= storedLanes)
+                return V(SampleType(0));
+
+            int base[numReadSlots];
+            SampleType frac[numReadSlots];
+            for (int r = 0; r < numReads; ++r)
+                locate(delays[r], position, base[r], frac[r]);
+
+            V taps[Interp::numTaps];
+            SampleType values[numReadSlots];
+            for (int k = 0; k < Interp::numTaps; ++k)
+            {
+                for (int r = 0; r < numReads; ++r)
+                    values[r] = buffer[static_cast<size_t>(((base[r] - k) & mask) * storedLanes + lane)];
+
+                taps[k] = V::load(values);
+            }
+
+            V unused(SampleType(0));
+            return Interp::interpolate(taps, V::load(frac), unused);
+        }
+
+        template <typename V>
+        V readTapsWhole(int lane, const SampleType* delays, int position) noexcept
+        {
+            constexpr int numReads = LaneCount<V>::value;
+            constexpr auto numReadSlots = static_cast<size_t>(numReads);
+
+            if (lane >= storedLanes)
+                return V(SampleType(0));
+
+            SampleType values[numReadSlots];
+            for (int r = 0; r < numReads; ++r)
+                values[r] = buffer[static_cast<size_t>((locateWhole(delays[r], position) & mask) * storedLanes + lane)];
+
+            return V::load(values);
+        }
+
+        template <typename V>
+        void writeFrame(V value) noexcept
+        {
+            if (storedLanes == NumLanes)
+            {
+                value.store(buffer.data() + writePos * NumLanes);
+                return;
+            }
+
+            SampleType values[numLaneSlots];
+            value.store(values);
+            std::copy(values, values + storedLanes, buffer.begin() + writePos * storedLanes);
+        }
+
+        // Moves the write position on by numSamples frames
+        void advance(int numSamples = 1) noexcept
+        {
+            writePos = (writePos + numSamples) & mask;
+        }
+
+    private:
+        //==============================================================================
+        // Clamps the delay and finds the nearest tap and fractional part
+        void locate(SampleType delay, int position, int& base, SampleType& frac) const noexcept
+        {
+            delay = std::min(std::max(delay, static_cast<SampleType>(minDelaySamples)),
+                             static_cast<SampleType>(maxDelaySamples));
+
+            const int delayInt = static_cast<int>(delay);
+            frac = delay - static_cast<SampleType>(delayInt);
+            base = position - delayInt + Interp::tapsBefore;
+        }
+
+        // Frame position for a whole-sample delay; without interpolation taps
+        // the nearest sample may be a single sample old
+        int locateWhole(SampleType delay, int position) const noexcept
+        {
+            delay = std::min(std::max(delay, SampleType(1)), static_cast<SampleType>(maxDelaySamples));
+            return position - static_cast<int>(delay);
+        }
+
+        //==============================================================================
+        std::vector<SampleType> buffer;     // size frames of storedLanes samples
+        int storedLanes = NumLanes;
+        int size = 0;
+        int mask = 0;
+        int writePos = 0;
+        int maxDelaySamples = 0;
+
+        SampleType interpolatorState[numLaneSlots] {};
+    };
+}
+}
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+    DelayWave - Delay Parameters
+    Plain settings passed to the delay engine. They carry no code that
+    depends on the instruction set, so every kernel variant shares them
+    (see InstructionSet.h).
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ControlSignal.h"
+
+namespace DelayWaveDSP
+{
+    enum class KernelMode
+    {
+        Scalar,
+        Simd
+    };
+
+    enum class ChannelLayout
+    {
+        Mono,
+        Stereo,
+        MidSide,        // Stereo in, processed as mid (lane 0) and side (lane 1)
+        Discrete        // Any other count, each channel on its own lane
+    };
+
+    //==============================================================================
+    struct ToneSettings
+    {
+        float lowpassHz = 20000.0f;
+        float highpassHz = 0.0f;        // 0 = off
+        int slope = 1;                  // Stages per filter: 1 = 12 dB/oct, 2 = 24 dB/oct
+    };
+
+    enum class SaturationCurve
+    {
+        Off,
+        Tanh,
+        Tape,       // Asymmetric, adds even harmonics
+        HardClip
+    };
+
+    struct SaturationSettings
+    {
+        SaturationCurve curve = SaturationCurve::Off;
+        float drive = 1.0f;             // Input gain, 1 or more; the output is scaled back by 1 / drive
+    };
+
+    // Allpass diffusion in the feedback path (see Diffuser.h)
+    struct DiffusionSettings
+    {
+        static constexpr int minStages = 4;
+        static constexpr int maxStages = 8;
+
+        float amount = 0.0f;            // 0 = off, 1 = every stage fully in
+        int stages = minStages;
+    };
+
+    //==============================================================================
+    // Control data for one block, normally filled once per block by the
+    // processor. Read positions are always per-sample arrays of at least
+    // numSamples values; feedback and mix may be constant for the block.
+    // The tone filter glides to its settings over the block.
+    //
+    // In jump mode a second set of read positions is faded in while the
+    // time changes (see ReadHeadCrossfader.h). wholeSampleDelays promises
+    // that every read position is a whole number of samples, so the reads
+    // can skip interpolation.
+    struct DelayBlockParams
+    {
+        static constexpr int numLanes = 4;                  // Channels per engine (one SIMD frame)
+
+        const float* delaySamples[numLanes] {};             // Read position per channel (samples)
+        const float* jumpDelaySamples[numLanes] {};         // Second read head per channel, or nullptr when not jumping
+        ControlSignal jumpFade;                             // 0 = delaySamples, 1 = jumpDelaySamples
+        bool wholeSampleDelays = false;
+        ControlSignal feedback;                             // 0-1
+        ControlSignal mix;                                  // 0-1
+        ControlSignal sideFeedback;                         // 0-1, side lane in mid/side only
+        ToneSettings tone;
+        SaturationSettings saturation;                      // Applied to everything written into the ring
+        DiffusionSettings diffusion;                        // Smears what is fed back, before the saturator
+    };
+
+    // Lanes an engine keeps in its ring for numChannels channels: one or two
+    // for mono and stereo, a whole frame for wider groups. Lanes past these
+    // read back as silence, so feedback matrices leave them out.
+    inline constexpr int getRingLanes(int numChannels) noexcept
+    {
+        return numChannels <= 1 ? 1 : numChannels == 2 ? 2 : DelayBlockParams::numLanes;
+    }
+
+    //==============================================================================
+    // Extra read heads, one entry per tap. Set with DelayEngine::setTaps().
+    struct TapLayout
+    {
+        static constexpr int maxTaps = 8;
+
+        int numTaps = 0;
+        float time[maxTaps] {};         // Fraction of the main read position (0-1)
+        float gain[maxTaps] {};
+        float pan[maxTaps] {};          // -1 (left) to 1 (right)
+        float filterCoeff[maxTaps] {};  // One-pole coefficient 0-1
+    };
+}
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+    DelayWave - Delay Processor
+    The processor's handle on the multichannel delay. Each instruction set
+    variant of the kernels (DelayKernels.cpp) implements this interface
+    with its own build of MultichannelDelay, and createDelayProcessor()
+    returns the variant picked at startup. The interface only uses the
+    shared plain data types, so nothing built for one instruction set
+    leaks into code that runs on every CPU.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayParams.h"
+#include "FeedbackMatrix.h"
+#include "InstructionSet.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace DelayWaveDSP
+{
+    template <typename SampleType = float>
+    class DelayProcessor
+    {
+    public:
+        static constexpr int maxChannels = 16;
+
+        virtual ~DelayProcessor() = default;
+
+        //==============================================================================
+        // See MultichannelDelay for the details of each call
+        virtual void prepare(int maxDelaySamples, int numChannels, double sampleRate) = 0;
+        virtual void reset() = 0;
+        virtual void release() = 0;
+
+        virtual void setTaps(const TapLayout& layout) noexcept = 0;
+        virtual void setFeedbackMatrix(int group, const FeedbackMatrix& matrix) noexcept = 0;
+        virtual void setMidSide(bool shouldUseMidSide) noexcept = 0;
+
+        virtual int getNumChannels() const noexcept = 0;
+        virtual size_t getMemoryUsageBytes() const noexcept = 0;
+        virtual SampleType getWritePeak() const noexcept = 0;
+
+        virtual void process(SampleType* const* channels, int numChannels, int numSamples,
+                             const DelayBlockParams& params, const float* const* delaySamples,
+                             const float* const* jumpDelaySamples, KernelMode mode) noexcept = 0;
+
+        // The variant running this instance
+        virtual InstructionSet getInstructionSet() const noexcept = 0;
+    };
+
+    //==============================================================================
+    // One definition per compiled variant, in DelayKernels.cpp
+    template <InstructionSet Isa, typename SampleType>
+    std::unique_ptr<DelayProcessor<SampleType>> createDelayProcessorFor();
+
+    template <> std::unique_ptr<DelayProcessor<float>> createDelayProcessorFor<InstructionSet::Baseline, float>();
+    template <> std::unique_ptr<DelayProcessor<double>> createDelayProcessorFor<InstructionSet::Baseline, double>();
+
+   #if BEATCONNECT_SIMD_HAS_AVX2 && DELAYWAVE_X86
+    template <> std::unique_ptr<DelayProcessor<float>> createDelayProcessorFor<InstructionSet::Avx2, float>();
+    template <> std::unique_ptr<DelayProcessor<double>> createDelayProcessorFor<InstructionSet::Avx2, double>();
+   #endif
+
+   #if BEATCONNECT_SIMD_HAS_AVX512 && DELAYWAVE_X86
+    template <> std::unique_ptr<DelayProcessor<float>> createDelayProcessorFor<InstructionSet::Avx512, float>();
+    template <> std::unique_ptr<DelayProcessor<double>> createDelayProcessorFor<InstructionSet::Avx512, double>();
+   #endif
+
+    // The best variant that was both built and is supported by this CPU
+    inline InstructionSet getKernelInstructionSet() noexcept
+    {
+        [[maybe_unused]] const auto cpu = getCpuInstructionSet();
+
+       #if BEATCONNECT_SIMD_HAS_AVX512 && DELAYWAVE_X86
+        if (cpu == InstructionSet::Avx512)
+            return InstructionSet::Avx512;
+       #endif
+
+       #if BEATCONNECT_SIMD_HAS_AVX2 && DELAYWAVE_X86
+        if (cpu == InstructionSet::Avx512 || cpu == InstructionSet::Avx2)
+            return InstructionSet::Avx2;
+       #endif
+
+        return InstructionSet::Baseline;
+    }
+
+    template <typename SampleType>
+    std::unique_ptr<DelayProcessor<SampleType>> createDelayProcessor([[maybe_unused]] InstructionSet isa = getKernelInstructionSet())
+    {
+       #if BEATCONNECT_SIMD_HAS_AVX512 && DELAYWAVE_X86
+        if (isa == InstructionSet::Avx512)
+            return createDelayProcessorFor<InstructionSet::Avx512, SampleType>();
+       #endif
+
+       #if BEATCONNECT_SIMD_HAS_AVX2 && DELAYWAVE_X86
+        if (isa == InstructionSet::Avx2)
+            return createDelayProcessorFor<InstructionSet::Avx2, SampleType>();
+       #endif
+
+        return createDelayProcessorFor<InstructionSet::Baseline, SampleType>();
+    }
+}
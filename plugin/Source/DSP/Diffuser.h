@@ -0,0 +1,268 @@
+/*
+  ==============================================================================
+    DelayWave - Diffuser
+    A chain of modulated allpass stages in the feedback path. Every pass
+    round the loop smears the repeats further, so echoes blur into a wash.
+
+    All stages live in one contiguous block, allocated in prepare(). Each
+    stage owns a power-of-two region of it. Lanes are interleaved as in
+    DelayLine, so one frame of a stage loads as a SIMD vector. Each lane
+    reads its own stage lengths, slightly detuned, so the channels
+    decorrelate. A slow sine per stage moves the read positions (linear
+    interpolation), so the chain does not ring at fixed frequencies.
+
+    Each stage blends between its input and its allpass output. Amount and
+    stage count changes glide that blend across the block, so adding a
+    stage or turning the diffuser off never steps the feedback. Stages
+    whose blend is 0 are skipped, and they restart from silence when they
+    come back.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayParams.h"
+#include "SimdVec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace DelayWaveDSP
+{
+inline namespace DELAYWAVE_ISA
+{
+    template <typename SampleType>
+    class Diffuser
+    {
+    public:
+        static constexpr int numLanes = DelayBlockParams::numLanes;
+        static constexpr int minStages = DiffusionSettings::minStages;
+        static constexpr int maxStages = DiffusionSettings::maxStages;
+
+        //==============================================================================
+        // Allocates every stage for this sample rate
+        void prepare(double newSampleRate)
+        {
+            sampleRate = newSampleRate;
+            int offset = 0;
+
+            for (int s = 0; s < maxStages; ++s)
+            {
+                const double longest = (stageMs[s] * laneScale[numLanes - 1] + modulationMs) * 0.001 * sampleRate + 2.0;
+
+                int size = 1;
+                while (size < longest)
+                    size <<= 1;
+
+                stageOffset[s] = offset;
+                stageMask[s] = size - 1;
+                offset += size;
+            }
+
+            buffer.assign(static_cast<size_t>(offset * numLanes), SampleType(0));
+
+            // The sizes are powers of two, so wrapping at the largest keeps
+            // every stage's position intact
+            positionMask = *std::max_element(std::begin(stageMask), std::end(stageMask));
+
+            reset();
+        }
+
+        void reset()
+        {
+            std::fill(buffer.begin(), buffer.end(), SampleType(0));
+            writePos = 0;
+            numActive = 0;
+
+            for (int s = 0; s < maxStages; ++s)
+            {
+                blend[s] = blendStart[s] = blendStep[s] = SampleType(0);
+                phase[s] = s / static_cast<double>(maxStages);
+                updateModulation(s);
+            }
+        }
+
+        void release()
+        {
+            std::vector<SampleType>().swap(buffer);
+        }
+
+        size_t getMemoryUsageBytes() const noexcept { return buffer.capacity() * sizeof(SampleType); }
+
+        //==============================================================================
+        // Sets the blend of every stage to reach by the end of the next
+        // numSamples and moves the modulation on by that much
+        void setTarget(const DiffusionSettings& settings, int numSamples) noexcept
+        {
+            const int stages = std::clamp(settings.stages, minStages, maxStages);
+            const auto amount = static_cast<SampleType>(std::clamp(settings.amount, 0.0f, 1.0f));
+            const SampleType scale = SampleType(1) / static_cast<SampleType>(std::max(1, numSamples));
+            numActive = 0;
+
+            for (int s = 0; s < maxStages; ++s)
+            {
+                const SampleType target = s < stages ? amount : SampleType(0);
+
+                // Blends are never negative, so zero is the only value at or below it
+                if (blend[s] <= SampleType(0) && target <= SampleType(0))
+                    continue;
+
+                // A stage coming back starts from silence
+                if (blend[s] <= SampleType(0))
+                    clearStage(s);
+
+                blendStart[s] = blend[s];
+                blendStep[s] = (target - blend[s]) * scale;
+                blend[s] = target;
+                activeStages[numActive++] = s;
+
+                for (int lane = 0; lane < numLanes; ++lane)
+                    delayStart[s][lane] = delayEnd[s][lane];
+
+                phase[s] += stageRateHz[s] * numSamples / sampleRate;
+                phase[s] -= std::floor(phase[s]);
+                updateModulation(s);
+
+                for (int lane = 0; lane < numLanes; ++lane)
+                    delayStep[s][lane] = (delayEnd[s][lane] - delayStart[s][lane]) * scale;
+            }
+        }
+
+        bool isActive() const noexcept { return numActive > 0; }
+
+        // Moves the write position on once a block has been processed
+        void advance(int numSamples) noexcept
+        {
+            writePos = (writePos + numSamples) & positionMask;
+        }
+
+        //==============================================================================
+        // One lane at block position i. Lanes are independent, so a kernel
+        // may run them one after the other.
+        SampleType processLane(int lane, SampleType x, int i) noexcept
+        {
+            const int position = writePos + i;
+
+            for (int k = 0; k < numActive; ++k)
+            {
+                const int s = activeStages[k];
+                const SampleType delayed = readLane(s, lane, delayStart[s][lane] + delayStep[s][lane] * static_cast<SampleType>(i), position);
+                const SampleType w = x + allpassGain * delayed;
+                buffer[index(s, lane, position)] = w;
+
+                const SampleType mix = blendStart[s] + blendStep[s] * static_cast<SampleType>(i);
+                x = x + mix * ((delayed - allpassGain * w) - x);
+            }
+
+            return x;
+        }
+
+        // All lanes at block position i, with the same arithmetic as processLane()
+        template <typename V>
+        V processFrame(V x, int i) noexcept
+        {
+            const int position = writePos + i;
+            const V gain(allpassGain);
+
+            for (int k = 0; k < numActive; ++k)
+            {
+                const int s = activeStages[k];
+
+                SampleType delays[numLanes];
+                for (int lane = 0; lane < numLanes; ++lane)
+                    delays[lane] = delayStart[s][lane] + delayStep[s][lane] * static_cast<SampleType>(i);
+
+                const V delayed = readFrame<V>(s, delays, position);
+                const V w = x + gain * delayed;
+                w.store(buffer.data() + index(s, 0, position));
+
+                const V mix(blendStart[s] + blendStep[s] * static_cast<SampleType>(i));
+                x = x + mix * ((delayed - gain * w) - x);
+            }
+
+            return x;
+        }
+
+    private:
+        //==============================================================================
+        size_t index(int stage, int lane, int position) const noexcept
+        {
+            return static_cast<size_t>((stageOffset[stage] + (position & stageMask[stage])) * numLanes + lane);
+        }
+
+        SampleType readLane(int stage, int lane, SampleType delay, int position) const noexcept
+        {
+            const int whole = static_cast<int>(delay);
+            const SampleType frac = delay - static_cast<SampleType>(whole);
+            const SampleType a = buffer[index(stage, lane, position - whole)];
+            const SampleType b = buffer[index(stage, lane, position - whole - 1)];
+            return a + frac * (b - a);
+        }
+
+        template <typename V>
+        V readFrame(int stage, const SampleType* delays, int position) const noexcept
+        {
+            SampleType a[numLanes], b[numLanes], frac[numLanes];
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                const int whole = static_cast<int>(delays[lane]);
+                frac[lane] = delays[lane] - static_cast<SampleType>(whole);
+                a[lane] = buffer[index(stage, lane, position - whole)];
+                b[lane] = buffer[index(stage, lane, position - whole - 1)];
+            }
+
+            const V va = V::load(a);
+            return va + V::load(frac) * (V::load(b) - va);
+        }
+
+        // Read positions at the current phase; the lanes are spread a
+        // quarter cycle apart
+        void updateModulation(int stage) noexcept
+        {
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                const double wobble = std::sin(2.0 * pi * (phase[stage] + 0.25 * lane));
+                const double ms = stageMs[stage] * laneScale[lane] + 0.5 * modulationMs * (1.0 + wobble);
+                delayEnd[stage][lane] = static_cast<SampleType>(std::max(1.0, ms * 0.001 * sampleRate));
+            }
+        }
+
+        void clearStage(int stage) noexcept
+        {
+            const auto first = buffer.begin() + stageOffset[stage] * numLanes;
+            std::fill(first, first + (stageMask[stage] + 1) * numLanes, SampleType(0));
+        }
+
+        //==============================================================================
+        static constexpr double pi = 3.14159265358979323846;
+        static constexpr SampleType allpassGain = SampleType(0.6);
+        static constexpr double modulationMs = 0.3;
+
+        // Mutually prime-ish lengths, short and long stages interleaved
+        static constexpr double stageMs[maxStages] = { 4.3, 3.1, 7.3, 5.9, 10.7, 8.9, 13.9, 12.1 };
+        static constexpr double stageRateHz[maxStages] = { 0.31, 0.43, 0.53, 0.67, 0.71, 0.83, 0.97, 1.09 };
+        static constexpr double laneScale[numLanes] = { 1.0, 1.04, 1.09, 1.13 };   // Ascending
+
+        std::vector<SampleType> buffer;     // Every stage, one region each
+        int stageOffset[maxStages] {};      // In frames
+        int stageMask[maxStages] {};
+        int positionMask = 0;
+        int writePos = 0;
+        double sampleRate = 44100.0;
+
+        int activeStages[maxStages] {};
+        int numActive = 0;
+
+        SampleType blend[maxStages] {};     // Reached at the end of the block
+        SampleType blendStart[maxStages] {};
+        SampleType blendStep[maxStages] {};
+
+        double phase[maxStages] {};
+        SampleType delayStart[maxStages][numLanes] {};
+        SampleType delayStep[maxStages][numLanes] {};
+        SampleType delayEnd[maxStages][numLanes] {};
+    };
+}
+}
@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+    DelayWave - Feedback Matrix
+    Mixing applied to the delay lanes on their way back into the ring.
+    Identity keeps every channel on its own line; ping-pong swaps the
+    stereo pairs, and the diffuse mode runs the lanes as a feedback delay
+    network through a scaled Hadamard matrix. Every preset is orthogonal,
+    so the loop gain stays set by the feedback amount alone.
+
+    A matrix covers one group of four lanes. Lanes that are not part of a
+    left/right image (centre, LFE) can be left out of the mixing.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FloatCompare.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace DelayWaveDSP
+{
+    struct FeedbackMatrix
+    {
+        static constexpr int size = 4;
+
+        float gains[size][size] {};             // gains[to][from]
+
+        // Read position of each lane relative to its source channel. Lanes
+        // beyond the processed channels only matter once the matrix feeds
+        // them, and need distinct lengths to diffuse.
+        float laneDelayScale[size] { 1.0f, 1.0f, 1.0f, 1.0f };
+
+        // Only meaningful with at least two channels; a mono engine falls
+        // back to identity
+        bool needsStereoPair = false;
+
+        bool isIdentity() const noexcept
+        {
+            for (int to = 0; to < size; ++to)
+                for (int from = 0; from < size; ++from)
+                    if (! exactlyEqual(gains[to][from], to == from ? 1.0f : 0.0f))
+                        return false;
+
+            return true;
+        }
+
+        //==============================================================================
+        // fixedLanes is a bit mask of lanes in the group that keep their own
+        // feedback in every mode, such as the centre and LFE of a surround
+        // layout, or lanes the engine's ring does not store. The other lanes,
+        // channels and spare lanes alike, take part.
+
+        static FeedbackMatrix identity() noexcept
+        {
+            FeedbackMatrix m;
+            for (int i = 0; i < size; ++i)
+                m.gains[i][i] = 1.0f;
+            return m;
+        }
+
+        // Swaps left/right pairs, so repeats alternate sides. The free lanes
+        // pair up in order, and one left over keeps its own feedback. This
+        // is the 90 degree case of a 2x2 rotation, without the sign flip.
+        static FeedbackMatrix pingPong(unsigned int fixedLanes = 0) noexcept
+        {
+            int lanes[size];
+            const int numLanes = getFreeLanes(fixedLanes, lanes);
+
+            auto m = identity();
+
+            for (int i = 0; i + 1 < numLanes; i += 2)
+            {
+                const int a = lanes[i];
+                const int b = lanes[i + 1];
+                m.gains[a][a] = m.gains[b][b] = 0.0f;
+                m.gains[a][b] = m.gains[b][a] = 1.0f;
+            }
+
+            m.needsStereoPair = true;
+            return m;
+        }
+
+        // Hadamard matrix over the free lanes, scaled to be orthogonal; three
+        // free lanes, which have no Hadamard matrix, get a Householder
+        // reflection instead. Free lanes past the first pair run at lengths
+        // that share no simple ratio with it.
+        static FeedbackMatrix diffuse(unsigned int fixedLanes = 0) noexcept
+        {
+            constexpr float signs[size][size] = {
+                { 1.0f,  1.0f,  1.0f,  1.0f },
+                { 1.0f, -1.0f,  1.0f, -1.0f },
+                { 1.0f,  1.0f, -1.0f, -1.0f },
+                { 1.0f, -1.0f, -1.0f,  1.0f }
+            };
+
+            constexpr float delayScales[size] { 1.0f, 1.0f, 0.7937f, 0.6300f };
+
+            int lanes[size];
+            const int numLanes = getFreeLanes(fixedLanes, lanes);
+            const float scale = 1.0f / std::sqrt(static_cast<float>(std::max(numLanes, 1)));
+
+            auto m = identity();
+
+            for (int i = 0; i < numLanes; ++i)
+            {
+                m.laneDelayScale[lanes[i]] = delayScales[i];
+
+                for (int j = 0; j < numLanes; ++j)
+                    m.gains[lanes[i]][lanes[j]] = numLanes == 3 ? (i == j ? 1.0f : 0.0f) - 2.0f / 3.0f
+                                                                : scale * signs[i][j];
+            }
+
+            return m;
+        }
+
+        // The same mixing for a stereo pair run as mid/side in lanes 0 and 1:
+        // the matrix seen through the mid/side transform, which is its own
+        // inverse up to scale. Ping-pong then keeps the mid and flips the
+        // side on every repeat, which is what swapping left and right does.
+        FeedbackMatrix toMidSide() const noexcept
+        {
+            constexpr float h = 0.70710678f;    // 1 / sqrt 2, so the transform is orthogonal
+
+            auto m = *this;
+
+            for (int from = 0; from < size; ++from)
+            {
+                const float mid = m.gains[0][from];
+                const float side = m.gains[1][from];
+                m.gains[0][from] = h * (mid + side);
+                m.gains[1][from] = h * (mid - side);
+            }
+
+            for (int to = 0; to < size; ++to)
+            {
+                const float mid = m.gains[to][0];
+                const float side = m.gains[to][1];
+                m.gains[to][0] = h * (mid + side);
+                m.gains[to][1] = h * (mid - side);
+            }
+
+            return m;
+        }
+
+    private:
+        // Lanes not in fixedLanes, in order; returns how many there are
+        static int getFreeLanes(unsigned int fixedLanes, int* lanes) noexcept
+        {
+            int numLanes = 0;
+
+            for (int lane = 0; lane < size; ++lane)
+                if ((fixedLanes & (1u << lane)) == 0)
+                    lanes[numLanes++] = lane;
+
+            return numLanes;
+        }
+    };
+}
@@ -0,0 +1,22 @@
+/*
+  ==============================================================================
+    DelayWave - Float Compare
+    Exact floating-point comparison, for the places that mean it, such as
+    skipping work when a setting has not changed. Works like
+    juce::exactlyEqual, which the DSP headers cannot use, and keeps
+    -Wfloat-equal quiet the same way.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+
+namespace DelayWaveDSP
+{
+    template <typename Type>
+    constexpr bool exactlyEqual(Type a, Type b) noexcept
+    {
+        return std::equal_to<Type>()(a, b);
+    }
+}
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+    DelayWave - Instruction Sets
+    The delay kernels are compiled once per instruction set (see
+    DelayKernels.cpp and beatconnect_configure_plugin), and the best one the
+    CPU supports is picked once at startup.
+
+    Every header with code that depends on the instruction set (SimdVec,
+    the interpolators, delay line, filters and engines) opens the inline
+    namespace DELAYWAVE_ISA, so each variant gets its own symbols and the
+    linker can never mix one variant's code into another. Plain data types
+    and the DelayProcessor interface live outside it and are shared.
+  ==============================================================================
+*/
+
+#pragma once
+
+// Set by the generated variant sources; anything else (the processor,
+// tools) sees the baseline
+#ifdef BEATCONNECT_SIMD_ISA
+ #define DELAYWAVE_ISA BEATCONNECT_SIMD_ISA
+#else
+ #define DELAYWAVE_ISA Baseline
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #define DELAYWAVE_X86 1
+ #if defined(_MSC_VER) && ! defined(__clang__)
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#else
+ #define DELAYWAVE_X86 0
+#endif
+
+namespace DelayWaveDSP
+{
+    enum class InstructionSet
+    {
+        Baseline,       // The build's default: SSE2 on x86-64, NEON on 64-bit ARM
+        Avx2,
+        Avx512
+    };
+
+    inline const char* getInstructionSetName(InstructionSet isa) noexcept
+    {
+        switch (isa)
+        {
+            case InstructionSet::Avx2:      return "AVX2";
+            case InstructionSet::Avx512:    return "AVX-512";
+            case InstructionSet::Baseline:  break;
+        }
+
+       #if DELAYWAVE_X86
+        return "SSE2";
+       #elif defined(__aarch64__) || defined(_M_ARM64)
+        return "NEON";
+       #else
+        return "Scalar";
+       #endif
+    }
+
+    //==============================================================================
+    namespace CpuFeatures
+    {
+       #if DELAYWAVE_X86
+        inline void cpuid(unsigned leaf, unsigned subleaf, unsigned (&regs)[4]) noexcept
+        {
+           #if defined(_MSC_VER) && ! defined(__clang__)
+            int r[4];
+            __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+            for (int i = 0; i < 4; ++i)
+                regs[i] = static_cast<unsigned>(r[i]);
+           #else
+            __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+           #endif
+        }
+
+        // Register state the OS saves on context switches (XCR0)
+        inline unsigned long long enabledStateMask() noexcept
+        {
+           #if defined(_MSC_VER) && ! defined(__clang__)
+            return _xgetbv(0);
+           #else
+            unsigned eax = 0, edx = 0;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<unsigned long long>(edx) << 32) | eax;
+           #endif
+        }
+       #endif
+
+        // The best instruction set this CPU and OS can run
+        inline InstructionSet detect() noexcept
+        {
+           #if DELAYWAVE_X86
+            unsigned regs[4] {};
+            cpuid(0, 0, regs);
+            const unsigned maxLeaf = regs[0];
+
+            cpuid(1, 0, regs);
+            const bool osSavesAvx = (regs[2] & (1u << 27)) != 0 && (regs[2] & (1u << 28)) != 0
+                                    && (enabledStateMask() & 0x6) == 0x6;
+
+            if (! osSavesAvx || maxLeaf < 7)
+                return InstructionSet::Baseline;
+
+            cpuid(7, 0, regs);
+            const unsigned features = regs[1];
+            const bool avx2 = (features & (1u << 5)) != 0;
+
+            // F, DQ, BW and VL, plus the opmask and upper ZMM state
+            const unsigned avx512Bits = (1u << 16) | (1u << 17) | (1u << 30) | (1u << 31);
+            const bool avx512 = (features & avx512Bits) == avx512Bits && (enabledStateMask() & 0xe6) == 0xe6;
+
+            return avx512 ? InstructionSet::Avx512
+                 : avx2   ? InstructionSet::Avx2
+                          : InstructionSet::Baseline;
+           #else
+            return InstructionSet::Baseline;
+           #endif
+        }
+    }
+
+    // Detected once per process
+    inline InstructionSet getCpuInstructionSet() noexcept
+    {
+        static const InstructionSet isa = CpuFeatures::detect();
+        return isa;
+    }
+}
@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+    DelayWave - Delay Interpolators
+    Fractional-delay policies for DelayLine. Each policy describes which taps
+    it needs around the integer delay and how to combine them, and is written
+    once for both float and Vec4<float> so scalar and SIMD reads share it.
+
+    initialise() builds any shared tables and is called from prepare().
+
+    Taps are passed nearest-first: taps[0] sits tapsBefore samples closer
+    than the integer delay. frac is the fractional part of the delay (0-1).
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SimdVec.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace DelayWaveDSP
+{
+inline namespace DELAYWAVE_ISA
+{
+namespace Interpolation
+{
+    //==============================================================================
+    // Integer delay, fractional part ignored
+    struct None
+    {
+        static constexpr int numTaps = 1;
+        static constexpr int tapsBefore = 0;
+        static constexpr bool hasState = false;
+        static void initialise() {}
+
+        template <typename V>
+        static V interpolate(const V* taps, V, V&) noexcept { return taps[0]; }
+    };
+
+    //==============================================================================
+    struct Linear
+    {
+        static constexpr int numTaps = 2;
+        static constexpr int tapsBefore = 0;
+        static constexpr bool hasState = false;
+        static void initialise() {}
+
+        template <typename V>
+        static V interpolate(const V* taps, V frac, V&) noexcept
+        {
+            return taps[0] + frac * (taps[1] - taps[0]);
+        }
+    };
+
+    //==============================================================================
+    // Third-order Lagrange over four taps, evaluated at t = frac + 1
+    struct Lagrange3
+    {
+        static constexpr int numTaps = 4;
+        static constexpr int tapsBefore = 1;
+        static constexpr bool hasState = false;
+        static void initialise() {}
+
+        template <typename V>
+        static V interpolate(const V* taps, V frac, V&) noexcept
+        {
+            const V t = frac + V(1.0f);
+            const V d1 = t - V(1.0f);
+            const V d2 = t - V(2.0f);
+            const V d3 = t - V(3.0f);
+
+            using Sample = decltype(getLane(std::declval<V>(), 0));
+            const V sixth(static_cast<Sample>(1.0 / 6.0));
+
+            const V c0 = V(0.0f) - d1 * d2 * d3 * sixth;
+            const V c1 = d2 * d3 * V(0.5f);
+            const V c2 = V(0.0f) - d1 * d3 * V(0.5f);
+            const V c3 = d1 * d2 * sixth;
+
+            return taps[0] * c0 + t * (taps[1] * c1 + taps[2] * c2 + taps[3] * c3);
+        }
+    };
+
+    //==============================================================================
+    // First-order Thiran allpass. Flat magnitude response, but it keeps one
+    // sample of state per lane, so each lane must be read exactly once per
+    // sample and fast delay sweeps produce small transients.
+    struct Thiran
+    {
+        static constexpr int numTaps = 2;
+        static constexpr int tapsBefore = 1;
+        static constexpr bool hasState = true;
+        static void initialise() {}
+
+        template <typename V>
+        static V interpolate(const V* taps, V frac, V& lastOutput) noexcept
+        {
+            // Allpass delay D = frac + 1 measured from taps[0]: a = (1 - D) / (1 + D)
+            const V a = (V(0.0f) - frac) / (frac + V(2.0f));
+            lastOutput = a * (taps[0] - lastOutput) + taps[1];
+            return lastOutput;
+        }
+    };
+
+    //==============================================================================
+    // 8-tap Hann-windowed sinc. Coefficients come from a shared table of
+    // fractional positions with linear interpolation between rows.
+    struct WindowedSinc
+    {
+        static constexpr int numTaps = 8;
+        static constexpr int tapsBefore = numTaps / 2 - 1;
+        static constexpr bool hasState = false;
+
+        template <typename V>
+        static V interpolate(const V* taps, V frac, V&) noexcept
+        {
+            constexpr int lanes = LaneCount<V>::value;
+            const auto& table = Table::get();
+
+            float weights[numTaps][static_cast<size_t>(lanes)];
+
+            using Sample = decltype(getLane(frac, 0));
+
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                // In the sample type: a double fraction just below 1 would
+                // round up to 1.0f. The last row pair is used for the end.
+                const Sample pos = getLane(frac, lane) * Table::numPhases;
+                const int row = std::min(static_cast<int>(pos), Table::numPhases - 1);
+                const float blend = static_cast<float>(pos - static_cast<Sample>(row));
+                const float* a = table.rows[static_cast<size_t>(row)].data();
+                const float* b = table.rows[static_cast<size_t>(row + 1)].data();
+
+                for (int k = 0; k < numTaps; ++k)
+                    weights[k][lane] = a[k] + blend * (b[k] - a[k]);
+            }
+
+            V sum(0.0f);
+            for (int k = 0; k < numTaps; ++k)
+                sum = sum + taps[k] * loadWeights<V>(weights[k]);
+
+            return sum;
+        }
+
+        // Build the shared table off the audio thread
+        static void initialise() { Table::get(); }
+
+    private:
+        struct Table
+        {
+            static constexpr int numPhases = 512;
+            std::array<std::array<float, numTaps>, numPhases + 1> rows;
+
+            Table()
+            {
+                constexpr double pi = 3.141592653589793;
+
+                for (int p = 0; p <= numPhases; ++p)
+                {
+                    const double frac = static_cast<double>(p) / numPhases;
+                    double sum = 0.0;
+                    double w[numTaps];
+
+                    for (int k = 0; k < numTaps; ++k)
+                    {
+                        const double x = (k - tapsBefore) - frac;   // Tap distance from the read point
+                        const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(pi * x) / (pi * x);
+                        const double window = 0.5 + 0.5 * std::cos(pi * x / (numTaps / 2));
+                        w[k] = sinc * window;
+                        sum += w[k];
+                    }
+
+                    // Unity gain at DC for every fractional position
+                    for (int k = 0; k < numTaps; ++k)
+                        rows[static_cast<size_t>(p)][static_cast<size_t>(k)] = static_cast<float>(w[k] / sum);
+                }
+            }
+
+            static const Table& get()
+            {
+                static const Table table;
+                return table;
+            }
+        };
+
+        template <typename V>
+        static V loadWeights(const float* w) noexcept
+        {
+            if constexpr (LaneCount<V>::value == 1)
+                return V(w[0]);
+            else
+                return V::fromValues(w[0], w[1], w[2], w[3]);
+        }
+    };
+}
+}
+}
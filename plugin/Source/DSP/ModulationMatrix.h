@@ -0,0 +1,305 @@
+/*
+  ==============================================================================
+    DelayWave - Modulation Matrix
+    A few routings from modulation sources (the main LFO, a second LFO, an
+    envelope follower on the input and a smooth random source) to the
+    delay's controls. Sources and routings are only evaluated at control
+    rate, once every N samples; each destination's sum is then ramped
+    linearly to the next control point into its own buffer, so the audio
+    code reads plain per-sample arrays. Another routing costs a multiply-add
+    per control point, not per sample.
+
+    Destinations without a routing report a constant 0, so the audio code
+    keeps its steady-state paths for them.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ControlSignal.h"
+#include "Lfo.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace DelayWaveDSP
+{
+    enum class ModSource
+    {
+        Off,
+        Lfo1,           // The main LFO, as rendered for the first channel
+        Lfo2,
+        Envelope,       // Input level, 0 to 1
+        Random          // Smooth random
+    };
+
+    enum class ModDestination
+    {
+        Time,
+        Feedback,
+        Tone,
+        Mix,
+        Pan
+    };
+
+    struct ModRouting
+    {
+        ModSource source = ModSource::Off;
+        ModDestination destination = ModDestination::Time;
+        float amount = 0.0f;            // -1 to 1
+    };
+
+    //==============================================================================
+    class ModulationMatrix
+    {
+    public:
+        static constexpr int maxRoutings = 4;
+        static constexpr int numSources = 5;
+        static constexpr int numDestinations = 5;
+        static constexpr int defaultControlInterval = 32;
+
+        //==============================================================================
+        void prepare(double newSampleRate, int maxBlockSizeToUse, int controlIntervalToUse = defaultControlInterval)
+        {
+            sampleRate = newSampleRate;
+            maxBlockSize = std::max(1, maxBlockSizeToUse);
+            controlInterval = std::max(1, controlIntervalToUse);
+            outputs.assign(static_cast<size_t>(maxBlockSize * numDestinations), 0.0f);
+            setEnvelope(attackMs, releaseMs);
+            reset();
+        }
+
+        void reset()
+        {
+            samplesToNextUpdate = 0;
+            envelope = envelopePeak = 0.0f;
+            lfo2Phase = randomPhase = 0.0;
+            lfo2Cycle = 0;
+            randomCycle = randomSeed;
+            current.fill(0.0f);
+            step.fill(0.0f);
+        }
+
+        int getControlInterval() const noexcept { return controlInterval; }
+        size_t getMemoryUsageBytes() const noexcept { return outputs.capacity() * sizeof(float); }
+
+        //==============================================================================
+        void setRouting(int slot, const ModRouting& routing) noexcept
+        {
+            if (slot >= 0 && slot < maxRoutings)
+                routings[static_cast<size_t>(slot)] = routing;
+        }
+
+        void setLfo2(float rateHz, LfoShape shape) noexcept
+        {
+            lfo2Rate = rateHz;
+            lfo2Shape = shape;
+        }
+
+        void setRandomRate(float rateHz) noexcept { randomRate = rateHz; }
+
+        void setEnvelope(float attackMsToUse, float releaseMsToUse) noexcept
+        {
+            attackMs = attackMsToUse;
+            releaseMs = releaseMsToUse;
+
+            // One-pole coefficients per control step
+            const auto coeff = [this](float ms)
+            {
+                return static_cast<float>(1.0 - std::exp(-controlInterval / (std::max(0.1f, ms) * 0.001 * sampleRate)));
+            };
+
+            attackCoeff = coeff(attackMs);
+            releaseCoeff = coeff(releaseMs);
+        }
+
+        // True when a routing with a non-zero amount targets the destination
+        bool isRouted(ModDestination destination) const noexcept
+        {
+            for (const auto& routing : routings)
+                if (isActive(routing) && routing.destination == destination)
+                    return true;
+
+            return false;
+        }
+
+        //==============================================================================
+        // Advances by numSamples (at most the prepared block size). lfo1 is
+        // the main LFO's output for the block and input the audio about to
+        // be processed, used by the envelope follower.
+        template <typename SampleType>
+        void process(const float* lfo1, const SampleType* const* input, int numChannels, int numSamples) noexcept
+        {
+            numSamples = std::min(numSamples, maxBlockSize);
+            updateActiveSet();
+
+            if (routedMask == 0)
+                return;
+
+            for (int i = 0; i < numSamples;)
+            {
+                if (samplesToNextUpdate == 0)
+                {
+                    updateControlPoint(lfo1[i]);
+                    samplesToNextUpdate = controlInterval;
+                }
+
+                const int run = std::min(samplesToNextUpdate, numSamples - i);
+
+                if (usesSource(ModSource::Envelope))
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        for (int j = i; j < i + run; ++j)
+                            envelopePeak = std::max(envelopePeak, static_cast<float>(std::abs(input[ch][j])));
+
+                for (int d = 0; d < numDestinations; ++d)
+                {
+                    if ((routedMask & (1u << d)) == 0)
+                        continue;
+
+                    float* out = outputs.data() + d * maxBlockSize;
+                    float value = current[static_cast<size_t>(d)];
+                    const float delta = step[static_cast<size_t>(d)];
+
+                    for (int j = i; j < i + run; ++j)
+                    {
+                        value += delta;
+                        out[j] = value;
+                    }
+
+                    current[static_cast<size_t>(d)] = value;
+                }
+
+                samplesToNextUpdate -= run;
+                i += run;
+            }
+        }
+
+        // A destination's modulation for the last processed block, -1 to 1
+        ControlSignal get(ModDestination destination) const noexcept
+        {
+            const int d = static_cast<int>(destination);
+
+            if ((routedMask & (1u << d)) == 0)
+                return ControlSignal::constant(0.0f);
+
+            return { outputs.data() + d * maxBlockSize, current[static_cast<size_t>(d)] };
+        }
+
+    private:
+        //==============================================================================
+        static bool isActive(const ModRouting& routing) noexcept
+        {
+            return routing.source != ModSource::Off && std::abs(routing.amount) > 0.0f;
+        }
+
+        bool usesSource(ModSource source) const noexcept
+        {
+            return (sourceMask & (1u << static_cast<int>(source))) != 0;
+        }
+
+        void updateActiveSet() noexcept
+        {
+            unsigned destinations = 0, sources = 0;
+
+            for (const auto& routing : routings)
+            {
+                if (isActive(routing))
+                {
+                    destinations |= 1u << static_cast<int>(routing.destination);
+                    sources |= 1u << static_cast<int>(routing.source);
+                }
+            }
+
+            // A destination that loses its last routing starts from 0 again
+            for (int d = 0; d < numDestinations; ++d)
+                if ((destinations & (1u << d)) == 0)
+                    current[static_cast<size_t>(d)] = step[static_cast<size_t>(d)] = 0.0f;
+
+            routedMask = destinations;
+            sourceMask = sources;
+        }
+
+        // Evaluates the sources and sets each destination's ramp towards its
+        // new sum over the next interval
+        void updateControlPoint(float lfo1Value) noexcept
+        {
+            const double seconds = controlInterval / sampleRate;
+            std::array<float, numSources> values {};
+            values[static_cast<size_t>(ModSource::Lfo1)] = lfo1Value;
+
+            if (usesSource(ModSource::Lfo2))
+            {
+                values[static_cast<size_t>(ModSource::Lfo2)] = Lfo::evaluateAt(lfo2Shape, lfo2Phase, lfo2Cycle);
+                advance(lfo2Phase, lfo2Cycle, lfo2Rate * seconds);
+            }
+
+            if (usesSource(ModSource::Envelope))
+            {
+                envelope += (envelopePeak > envelope ? attackCoeff : releaseCoeff) * (envelopePeak - envelope);
+                envelopePeak = 0.0f;
+                values[static_cast<size_t>(ModSource::Envelope)] = std::min(envelope, 1.0f);
+            }
+
+            if (usesSource(ModSource::Random))
+            {
+                values[static_cast<size_t>(ModSource::Random)] = Lfo::evaluateAt(LfoShape::SmoothRandom, randomPhase, randomCycle);
+                advance(randomPhase, randomCycle, randomRate * seconds);
+            }
+
+            std::array<float, numDestinations> targets {};
+            for (const auto& routing : routings)
+                if (isActive(routing))
+                    targets[static_cast<size_t>(routing.destination)] += routing.amount * values[static_cast<size_t>(routing.source)];
+
+            for (int d = 0; d < numDestinations; ++d)
+            {
+                const float target = std::clamp(targets[static_cast<size_t>(d)], -1.0f, 1.0f);
+                step[static_cast<size_t>(d)] = (target - current[static_cast<size_t>(d)]) / static_cast<float>(controlInterval);
+            }
+        }
+
+        static void advance(double& phase, std::int64_t& cycle, double increment) noexcept
+        {
+            phase += increment;
+            const double whole = std::floor(phase);
+            phase -= whole;
+            cycle += static_cast<std::int64_t>(whole);
+        }
+
+        //==============================================================================
+        std::array<ModRouting, maxRoutings> routings {};
+        unsigned routedMask = 0;        // Destinations with an active routing
+        unsigned sourceMask = 0;        // Sources used by an active routing
+
+        std::vector<float> outputs;     // maxBlockSize values per destination
+        std::array<float, numDestinations> current {};
+        std::array<float, numDestinations> step {};
+
+        double sampleRate = 44100.0;
+        int maxBlockSize = 0;
+        int controlInterval = defaultControlInterval;
+        int samplesToNextUpdate = 0;
+
+        float lfo2Rate = 0.3f;
+        LfoShape lfo2Shape = LfoShape::Sine;
+        double lfo2Phase = 0.0;
+        std::int64_t lfo2Cycle = 0;
+
+        // Far from the second LFO's cycles, so its random shapes differ
+        static constexpr std::int64_t randomSeed = std::int64_t(1) << 40;
+
+        float randomRate = 1.0f;
+        double randomPhase = 0.0;
+        std::int64_t randomCycle = randomSeed;
+
+        float attackMs = 10.0f;
+        float releaseMs = 200.0f;
+        float attackCoeff = 1.0f;
+        float releaseCoeff = 1.0f;
+        float envelope = 0.0f;
+        float envelopePeak = 0.0f;
+    };
+}
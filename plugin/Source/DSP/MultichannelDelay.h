@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+    DelayWave - Multichannel Delay
+    Runs any number of channels as groups of four on DelayEngine, so each
+    group is one SIMD frame and the cost grows with the number of groups
+    rather than with a fixed overhead per channel. Groups are sized from
+    the channel count passed to prepare().
+
+    Taps and feedback matrices apply within each group: channels 0-3 form
+    the first, 4-7 the second and so on. Each group takes its own feedback
+    matrix.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayEngine.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace DelayWaveDSP
+{
+inline namespace DELAYWAVE_ISA
+{
+    template <typename SampleType = float, typename Interp = Interpolation::Lagrange3>
+    class MultichannelDelay
+    {
+    public:
+        using Engine = DelayEngine<SampleType, Interp>;
+
+        static constexpr int channelsPerGroup = Engine::maxChannels;
+        static constexpr int maxChannels = 16;
+
+        //==============================================================================
+        // Only adds groups when the channel count grows; existing groups keep
+        // their memory if the new delay fits
+        void prepare(int maxDelaySamplesToUse, int numChannelsToUse, double sampleRate)
+        {
+            numChannels = std::clamp(numChannelsToUse, 1, maxChannels);
+            const int numGroups = (numChannels + channelsPerGroup - 1) / channelsPerGroup;
+
+            if (static_cast<int>(groups.size()) < numGroups)
+                groups.resize(static_cast<size_t>(numGroups));
+
+            activeGroups = numGroups;
+
+            for (int g = 0; g < activeGroups; ++g)
+                groups[static_cast<size_t>(g)].prepare(maxDelaySamplesToUse, groupSize(g), sampleRate);
+        }
+
+        void reset()
+        {
+            for (auto& group : groups)
+                group.reset();
+        }
+
+        void release()
+        {
+            std::vector<Engine>().swap(groups);
+            activeGroups = 0;
+        }
+
+        void setTaps(const TapLayout& layout) noexcept
+        {
+            for (int g = 0; g < activeGroups; ++g)
+                groups[static_cast<size_t>(g)].setTaps(layout);
+        }
+
+        // Per group, since which lanes take part depends on the channels in it
+        void setFeedbackMatrix(int group, const FeedbackMatrix& matrix) noexcept
+        {
+            if (group >= 0 && group < activeGroups)
+                groups[static_cast<size_t>(group)].setFeedbackMatrix(matrix);
+        }
+
+        // Mid/side only applies to a stereo layout, which is a single group
+        void setMidSide(bool shouldUseMidSide) noexcept
+        {
+            for (int g = 0; g < activeGroups; ++g)
+                groups[static_cast<size_t>(g)].setMidSide(shouldUseMidSide && numChannels == 2);
+        }
+
+        int getNumChannels() const noexcept { return numChannels; }
+        int getNumGroups() const noexcept { return activeGroups; }
+        int getMaximumDelayInSamples() const noexcept { return groups.empty() ? 0 : groups.front().getMaximumDelayInSamples(); }
+
+        // Largest magnitude written into any group's ring by the last process()
+        SampleType getWritePeak() const noexcept
+        {
+            SampleType peak = 0;
+            for (int g = 0; g < activeGroups; ++g)
+                peak = std::max(peak, groups[static_cast<size_t>(g)].getWritePeak());
+            return peak;
+        }
+
+        size_t getMemoryUsageBytes() const noexcept
+        {
+            size_t bytes = 0;
+            for (const auto& group : groups)
+                bytes += group.getMemoryUsageBytes();
+            return bytes;
+        }
+
+        //==============================================================================
+        // params carries the shared controls; delaySamples holds one read
+        // position array per channel and overrides params.delaySamples, and
+        // jumpDelaySamples (nullptr when not jumping) does the same for
+        // params.jumpDelaySamples.
+        void process(SampleType* const* channels, int numChannelsToProcess, int numSamples,
+                     const DelayBlockParams& params, const float* const* delaySamples,
+                     const float* const* jumpDelaySamples, KernelMode mode) noexcept
+        {
+            const int n = std::min(numChannelsToProcess, numChannels);
+
+            for (int g = 0; g < activeGroups; ++g)
+            {
+                const int first = g * channelsPerGroup;
+                const int count = std::min(channelsPerGroup, n - first);
+
+                if (count <= 0)
+                    break;
+
+                DelayBlockParams groupParams = params;
+                for (int ch = 0; ch < channelsPerGroup; ++ch)
+                {
+                    groupParams.delaySamples[ch] = ch < count ? delaySamples[first + ch] : nullptr;
+                    groupParams.jumpDelaySamples[ch] = ch < count && jumpDelaySamples != nullptr ? jumpDelaySamples[first + ch] : nullptr;
+                }
+
+                groups[static_cast<size_t>(g)].process(channels + first, count, numSamples, groupParams, mode);
+            }
+        }
+
+    private:
+        int groupSize(int group) const noexcept
+        {
+            return std::min(channelsPerGroup, numChannels - group * channelsPerGroup);
+        }
+
+        //==============================================================================
+        std::vector<Engine> groups;
+        int activeGroups = 0;
+        int numChannels = 0;
+    };
+}
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+    DelayWave - Read Head Crossfader
+    Jump mode for time changes. Instead of sliding one read head to the new
+    time (and bending the pitch on the way, like tape), the delay keeps two
+    heads at whole-sample positions: the one being heard, and the one at the
+    new time. A time change crossfades from the first to the second; once
+    the fade is over the second becomes the current head, and a change
+    that arrived meanwhile starts the next fade.
+
+    Positions are kept per time (the main time, and the side time in
+    mid/side), but they all jump together, so the engine needs a single
+    fade for every lane.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ControlSignal.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace DelayWaveDSP
+{
+    class ReadHeadCrossfader
+    {
+    public:
+        static constexpr int maxTimes = 2;
+        static constexpr double defaultFadeSeconds = 0.03;
+
+        //==============================================================================
+        void prepare(double sampleRate, double fadeSeconds = defaultFadeSeconds)
+        {
+            step = 1.0f / static_cast<float>(std::max(1.0, std::round(fadeSeconds * sampleRate)));
+            reset();
+        }
+
+        // The next process() settles on its targets without a fade
+        void reset() noexcept
+        {
+            settled = false;
+            fading = false;
+            fade = 0.0f;
+        }
+
+        // Settles on these read positions (samples); the next process()
+        // fades from there if its targets differ
+        void snapTo(const float* delaySamples, int numTimes) noexcept
+        {
+            for (int k = 0; k < std::min(numTimes, maxTimes); ++k)
+                current[k] = next[k] = std::round(delaySamples[k]);
+
+            settled = true;
+            fading = false;
+            fade = 0.0f;
+        }
+
+        //==============================================================================
+        // Follows the target read positions (samples) over numSamples. While
+        // a fade runs, its progress (0 = current head, 1 = next head) is
+        // written into buffer and returned as a ramp; otherwise the fade
+        // comes back as a constant 0.
+        ControlSignal process(const float* targetSamples, int numTimes, float* buffer, int numSamples) noexcept
+        {
+            numTimes = std::min(numTimes, maxTimes);
+
+            if (! settled)
+                snapTo(targetSamples, numTimes);
+
+            if (fading && fade >= 1.0f)
+            {
+                std::copy(next, next + maxTimes, current);
+                fading = false;
+                fade = 0.0f;
+            }
+
+            if (! fading)
+            {
+                // Both heads are whole samples, so any change is at least one
+                for (int k = 0; k < numTimes; ++k)
+                {
+                    next[k] = std::round(targetSamples[k]);
+                    fading = fading || std::abs(next[k] - current[k]) >= 0.5f;
+                }
+
+                if (! fading)
+                    return ControlSignal::constant(0.0f);
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                fade = std::min(1.0f, fade + step);
+                buffer[i] = fade;
+            }
+
+            return ControlSignal::perSample(buffer);
+        }
+
+        // Whole-sample read positions for the last processed block; the
+        // next head only differs while fading
+        float getCurrent(int index) const noexcept { return current[index]; }
+        float getNext(int index) const noexcept { return next[index]; }
+        bool isFading() const noexcept { return fading; }
+
+    private:
+        //==============================================================================
+        float current[maxTimes] {};
+        float next[maxTimes] {};
+        float fade = 0.0f;
+        float step = 1.0f;
+        bool fading = false;
+        bool settled = false;
+    };
+}
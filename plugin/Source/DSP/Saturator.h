@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+    DelayWave - Feedback Saturator
+    Waveshaper for the signal written back into the delay ring, with
+    first-order antiderivative antialiasing (ADAA). Instead of f(x) each
+    sample outputs the mean of f over the segment since the last input,
+
+        y = (F(x) - F(xPrev)) / (x - xPrev)
+
+    with F the antiderivative of f. That cuts the aliasing of hard drive by
+    roughly the same amount as 2x-4x oversampling, at the cost of half a
+    sample of delay. When two inputs are almost equal the quotient loses
+    precision, so it falls back to f at the midpoint.
+
+    F(xPrev) is kept with the input, so each sample evaluates F once. The
+    state is kept per lane and the maths is written once for one lane or a
+    whole Vec4 frame.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayParams.h"
+#include "FloatCompare.h"
+#include "SimdVec.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace DelayWaveDSP
+{
+inline namespace DELAYWAVE_ISA
+{
+    //==============================================================================
+    template <typename SampleType>
+    class Saturator
+    {
+    public:
+        static constexpr int numLanes = DelayBlockParams::numLanes;
+        static constexpr int numStateSlots = 2;     // Previous input, and F of it
+
+        //==============================================================================
+        void reset()
+        {
+            std::fill(std::begin(state[0]), std::end(state[0]), SampleType(0));
+            std::fill(std::begin(state[1]), std::end(state[1]), antiderivative(curve, SampleType(0)));
+        }
+
+        // Takes effect from the next sample. The previous inputs are
+        // rescaled for a new drive, so the ADAA difference stays continuous
+        // across the change. A new curve starts from a cleared state, since
+        // the inputs kept while the saturator was off are stale.
+        void setSettings(const SaturationSettings& settings) noexcept
+        {
+            const auto newDrive = static_cast<SampleType>(std::max(1.0f, settings.drive));
+
+            if (settings.curve != curve)
+            {
+                curve = settings.curve;
+                reset();
+            }
+            else if (! exactlyEqual(newDrive, drive))
+            {
+                for (int lane = 0; lane < numLanes; ++lane)
+                {
+                    const SampleType x = state[0][lane] * (newDrive / drive);
+                    state[0][lane] = x;
+                    state[1][lane] = antiderivative(curve, x);
+                }
+            }
+
+            drive = newDrive;
+            inverseDrive = SampleType(1) / drive;
+        }
+
+        bool isActive() const noexcept { return curve != SaturationCurve::Off; }
+
+        //==============================================================================
+        // Saturates one sample. V is SampleType (one lane) or
+        // Vec4<SampleType> (all lanes); states holds numStateSlots entries,
+        // loaded with loadState() and written back with storeState().
+        template <typename V>
+        V process(V x, V* states) const noexcept
+        {
+            switch (curve)
+            {
+                case SaturationCurve::Tanh:     return runAdaa<TanhCurve>(x, states);
+                case SaturationCurve::Tape:     return runAdaa<TapeCurve>(x, states);
+                case SaturationCurve::HardClip: return runAdaa<HardClipCurve>(x, states);
+                case SaturationCurve::Off:      break;
+            }
+
+            return x;
+        }
+
+        void loadState(SampleType* states, int lane) const noexcept
+        {
+            for (int slot = 0; slot < numStateSlots; ++slot)
+                states[slot] = state[slot][lane];
+        }
+
+        void storeState(const SampleType* states, int lane) noexcept
+        {
+            for (int slot = 0; slot < numStateSlots; ++slot)
+                state[slot][lane] = states[slot];
+        }
+
+        void loadState(Vec4<SampleType>* states) const noexcept
+        {
+            for (int slot = 0; slot < numStateSlots; ++slot)
+                states[slot] = Vec4<SampleType>::load(state[slot]);
+        }
+
+        void storeState(const Vec4<SampleType>* states) noexcept
+        {
+            for (int slot = 0; slot < numStateSlots; ++slot)
+                states[slot].store(state[slot]);
+        }
+
+    private:
+        //==============================================================================
+        // Below this input step, relative to the input level, the quotient
+        // is replaced by the midpoint. Every F here is zero at zero, so its
+        // rounding error scales with the input and quiet material keeps the
+        // quotient too. float keeps about 7 digits, so F differences need a
+        // wider margin. minLevel sends silence (0 / 0) to the midpoint.
+        static constexpr SampleType epsilon = std::is_same_v<SampleType, float> ? SampleType(1.0e-3)
+                                                                                 : SampleType(1.0e-6);
+        static constexpr SampleType minLevel = SampleType(1.0e-20);
+
+        template <typename Curve, typename V>
+        V runAdaa(V x, V* states) const noexcept
+        {
+            const V driven = x * V(drive);
+            const V previous = states[0];
+            const V antiderivativeNow = Curve::antiderivative(driven);
+
+            const V delta = driven - previous;
+            const V quotient = (antiderivativeNow - states[1]) / delta;
+            const V midpoint = Curve::apply((driven + previous) * V(SampleType(0.5)));
+
+            states[0] = driven;
+            states[1] = antiderivativeNow;
+
+            // The quotient of an almost-zero step is discarded lane by lane
+            const V level = vecMax(vecMax(vecAbs(driven), vecAbs(previous)), V(minLevel));
+            return selectLess(vecAbs(delta), V(epsilon) * level, midpoint, quotient) * V(inverseDrive);
+        }
+
+        static SampleType antiderivative(SaturationCurve c, SampleType x) noexcept
+        {
+            switch (c)
+            {
+                case SaturationCurve::Tanh:     return TanhCurve::antiderivative(x);
+                case SaturationCurve::Tape:     return TapeCurve::antiderivative(x);
+                case SaturationCurve::HardClip: return HardClipCurve::antiderivative(x);
+                case SaturationCurve::Off:      break;
+            }
+
+            return SampleType(0);
+        }
+
+        //==============================================================================
+        // tanh as an odd degree-7 polynomial p, fitted to within 0.017 and
+        // reaching 1 with zero slope at the knee: f(x) = p(c) with
+        // c = clamp(x, -knee, knee). As for the hard clip, F(x) = P(|c|) + |x| - |c|
+        // with P the even antiderivative of p, so both run as Vec4 maths.
+        struct TanhCurve
+        {
+            static constexpr SampleType knee = SampleType(2.4);
+            static constexpr SampleType a3 = SampleType(-0.2675689948148148);
+            static constexpr SampleType a5 = SampleType(0.04643880671296296);
+            static constexpr SampleType a7 = SampleType(-0.00305);
+
+            template <typename V>
+            static V apply(V x) noexcept
+            {
+                const V c = vecMin(vecMax(x, V(-knee)), V(knee));
+                const V c2 = c * c;
+                return c * (V(SampleType(1)) + c2 * (V(a3) + c2 * (V(a5) + c2 * V(a7))));
+            }
+
+            template <typename V>
+            static V antiderivative(V x) noexcept
+            {
+                const V a = vecAbs(x);
+                const V c = vecMin(a, V(knee));
+                const V c2 = c * c;
+                return c2 * (V(SampleType(0.5)) + c2 * (V(a3 / 4) + c2 * (V(a5 / 6) + c2 * V(a7 / 8)))) + (a - c);
+            }
+        };
+
+        // Algebraic sigmoid g(u) = u / sqrt(1 + u^2) with a bias, so positive
+        // peaks flatten earlier than negative ones. Scaled by s = 1 / g'(b) =
+        // (1 + b^2)^1.5 so small signals keep unity gain: f(x) = s (g(x + b) - g(b)),
+        // F(x) = s (r - r0 - g(b) x) with r = sqrt(1 + (x + b)^2) and
+        // r0 = sqrt(1 + b^2). That is evaluated as
+        // s x^2 (r0 - b (x + 2b) / (r + r0)) / (r0 (r + r0)), which has no
+        // cancellation and keeps its precision for small x. Only needs a
+        // vector sqrt.
+        struct TapeCurve
+        {
+            static constexpr SampleType bias = SampleType(0.3);
+            static constexpr SampleType biasOffset = SampleType(0.28734788556634544);  // g(bias)
+            static constexpr SampleType biasRoot = SampleType(1.0440306508910551);     // sqrt(1 + bias^2)
+            static constexpr SampleType slopeScale = SampleType(1.13799340947125);     // 1 / g'(bias)
+
+            template <typename V>
+            static V apply(V x) noexcept
+            {
+                const V u = x + V(bias);
+                return V(slopeScale) * (u / vecSqrt(V(SampleType(1)) + u * u) - V(biasOffset));
+            }
+
+            template <typename V>
+            static V antiderivative(V x) noexcept
+            {
+                const V u = x + V(bias);
+                const V rootSum = vecSqrt(V(SampleType(1)) + u * u) + V(biasRoot);
+                return V(slopeScale / biasRoot) * x * x * (V(biasRoot) - V(bias) * (u + V(bias)) / rootSum) / rootSum;
+            }
+        };
+
+        // f(x) = clamp(x, -1, 1). With c = min(|x|, 1), F(x) = c^2 / 2 + |x| - c
+        // covers both the x^2 / 2 middle and the |x| - 1/2 outer parts.
+        struct HardClipCurve
+        {
+            template <typename V>
+            static V apply(V x) noexcept
+            {
+                const V one(SampleType(1));
+                return vecMin(vecMax(x, V(SampleType(-1))), one);
+            }
+
+            template <typename V>
+            static V antiderivative(V x) noexcept
+            {
+                const V a = vecAbs(x);
+                const V c = vecMin(a, V(SampleType(1)));
+                return V(SampleType(0.5)) * c * c + (a - c);
+            }
+        };
+
+        //==============================================================================
+        SaturationCurve curve = SaturationCurve::Off;
+        SampleType drive = 1;
+        SampleType inverseDrive = 1;
+        SampleType state[numStateSlots][numLanes] {};
+    };
+}
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+    DelayWave - Silence Detector
+    Decides when an instance can stop processing. Everything the delay can
+    still play back was written into its ring within the last ring length,
+    so once the written signal has stayed below the threshold for that
+    long and the input is silent too, the output would be silent as well.
+    The instance then sleeps until the input comes back.
+
+    Also counts how many samples were processed awake and asleep, so the
+    saving can be reported.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace DelayWaveDSP
+{
+    class SilenceDetector
+    {
+    public:
+        static constexpr float defaultThreshold = 1.0e-6f;     // -120 dBFS
+
+        //==============================================================================
+        // holdSamples is the ring length, in the samples counted by the block
+        // calls below
+        void prepare(int holdSamplesToUse, float thresholdToUse = defaultThreshold)
+        {
+            holdSamples = std::max(1, holdSamplesToUse);
+            threshold = thresholdToUse;
+            reset();
+        }
+
+        // Wakes up and forgets the history and the duty cycle counts
+        void reset()
+        {
+            silentWriteSamples = 0;
+            sleeping = false;
+            activeSamples = sleepingSamples = 0;
+        }
+
+        //==============================================================================
+        // Called before a block with the input's peak. Returns true when the
+        // block can be skipped.
+        bool beginBlock(float inputPeak, int numSamples) noexcept
+        {
+            sleeping = inputPeak <= threshold && silentWriteSamples >= holdSamples;
+            (sleeping ? sleepingSamples : activeSamples) += static_cast<std::uint64_t>(numSamples);
+            return sleeping;
+        }
+
+        // Called after each processed block with the peak written into the ring
+        void endBlock(float writePeak, int numSamples) noexcept
+        {
+            silentWriteSamples = writePeak <= threshold ? std::min(holdSamples, silentWriteSamples + numSamples) : 0;
+        }
+
+        bool isSleeping() const noexcept { return sleeping; }
+
+        // Fraction of the samples since prepare() or reset() that were
+        // processed awake (1 = never slept)
+        float getActiveRatio() const noexcept
+        {
+            const auto total = activeSamples + sleepingSamples;
+            return total > 0 ? static_cast<float>(static_cast<double>(activeSamples) / static_cast<double>(total)) : 1.0f;
+        }
+
+    private:
+        //==============================================================================
+        int holdSamples = 1;
+        int silentWriteSamples = 0;
+        float threshold = defaultThreshold;
+        bool sleeping = false;
+
+        std::uint64_t activeSamples = 0;
+        std::uint64_t sleepingSamples = 0;
+    };
+}
@@ -0,0 +1,319 @@
+/*
+  ==============================================================================
+    DelayWave - SIMD Lane Vector
+    Four-lane vector used by the DSP kernels. Each lane carries one channel
+    (or one delay line), so L/R are processed side by side in one register.
+    Vec4<double> spans two 128-bit registers, or one 256-bit register in
+    the AVX2 and AVX-512 kernel variants (see InstructionSet.h).
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "InstructionSet.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define DELAYWAVE_SIMD_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+ #include <arm_neon.h>
+ #define DELAYWAVE_SIMD_NEON 1
+#endif
+
+// The AVX variants are compiled with target attributes rather than
+// compiler flags, so this follows the variant being built, not __AVX__
+#if DELAYWAVE_SIMD_SSE2 && (defined(BEATCONNECT_SIMD_AVX2) || defined(BEATCONNECT_SIMD_AVX512))
+ #include <immintrin.h>
+ #define DELAYWAVE_SIMD_AVX 1
+#endif
+
+namespace DelayWaveDSP
+{
+inline namespace DELAYWAVE_ISA
+{
+    //==============================================================================
+    // Portable fallback - plain arrays, written so the compiler can still
+    // auto-vectorize the per-lane loops.
+    template <typename T>
+    struct Vec4
+    {
+        static constexpr int size = 4;
+
+        T v[size];
+
+        Vec4() = default;
+        explicit Vec4(T x) noexcept                             { for (int i = 0; i < size; ++i) v[i] = x; }
+
+        static Vec4 fromValues(T a, T b, T c, T d) noexcept     { Vec4 r; r.v[0] = a; r.v[1] = b; r.v[2] = c; r.v[3] = d; return r; }
+        static Vec4 load(const T* p) noexcept                   { Vec4 r; for (int i = 0; i < size; ++i) r.v[i] = p[i]; return r; }
+        void store(T* p) const noexcept                         { for (int i = 0; i < size; ++i) p[i] = v[i]; }
+
+        T get(int lane) const noexcept                          { return v[lane]; }
+
+        friend Vec4 operator+(Vec4 a, Vec4 b) noexcept { Vec4 r; for (int i = 0; i < size; ++i) r.v[i] = a.v[i] + b.v[i]; return r; }
+        friend Vec4 operator-(Vec4 a, Vec4 b) noexcept { Vec4 r; for (int i = 0; i < size; ++i) r.v[i] = a.v[i] - b.v[i]; return r; }
+        friend Vec4 operator*(Vec4 a, Vec4 b) noexcept { Vec4 r; for (int i = 0; i < size; ++i) r.v[i] = a.v[i] * b.v[i]; return r; }
+        friend Vec4 operator/(Vec4 a, Vec4 b) noexcept { Vec4 r; for (int i = 0; i < size; ++i) r.v[i] = a.v[i] / b.v[i]; return r; }
+
+        static Vec4 min(Vec4 a, Vec4 b) noexcept { Vec4 r; for (int i = 0; i < size; ++i) r.v[i] = std::min(a.v[i], b.v[i]); return r; }
+        static Vec4 max(Vec4 a, Vec4 b) noexcept { Vec4 r; for (int i = 0; i < size; ++i) r.v[i] = std::max(a.v[i], b.v[i]); return r; }
+        static Vec4 abs(Vec4 a) noexcept         { Vec4 r; for (int i = 0; i < size; ++i) r.v[i] = std::abs(a.v[i]); return r; }
+        static Vec4 sqrt(Vec4 a) noexcept        { Vec4 r; for (int i = 0; i < size; ++i) r.v[i] = std::sqrt(a.v[i]); return r; }
+
+        // Per lane: a < b ? ifLess : otherwise
+        static Vec4 selectLess(Vec4 a, Vec4 b, Vec4 ifLess, Vec4 otherwise) noexcept
+        {
+            Vec4 r;
+            for (int i = 0; i < size; ++i)
+                r.v[i] = a.v[i] < b.v[i] ? ifLess.v[i] : otherwise.v[i];
+            return r;
+        }
+    };
+
+#if DELAYWAVE_SIMD_SSE2
+    //==============================================================================
+    template <>
+    struct Vec4<float>
+    {
+        static constexpr int size = 4;
+
+        __m128 v;
+
+        Vec4() = default;
+        explicit Vec4(__m128 x) noexcept : v(x) {}
+        explicit Vec4(float x) noexcept : v(_mm_set1_ps(x)) {}
+
+        static Vec4 fromValues(float a, float b, float c, float d) noexcept { return Vec4(_mm_setr_ps(a, b, c, d)); }
+        static Vec4 load(const float* p) noexcept                       { return Vec4(_mm_loadu_ps(p)); }
+        void store(float* p) const noexcept                             { _mm_storeu_ps(p, v); }
+
+        float get(int lane) const noexcept
+        {
+            alignas(16) float tmp[size];
+            _mm_store_ps(tmp, v);
+            return tmp[lane];
+        }
+
+        friend Vec4 operator+(Vec4 a, Vec4 b) noexcept { return Vec4(_mm_add_ps(a.v, b.v)); }
+        friend Vec4 operator-(Vec4 a, Vec4 b) noexcept { return Vec4(_mm_sub_ps(a.v, b.v)); }
+        friend Vec4 operator*(Vec4 a, Vec4 b) noexcept { return Vec4(_mm_mul_ps(a.v, b.v)); }
+        friend Vec4 operator/(Vec4 a, Vec4 b) noexcept { return Vec4(_mm_div_ps(a.v, b.v)); }
+
+        static Vec4 min(Vec4 a, Vec4 b) noexcept { return Vec4(_mm_min_ps(a.v, b.v)); }
+        static Vec4 max(Vec4 a, Vec4 b) noexcept { return Vec4(_mm_max_ps(a.v, b.v)); }
+        static Vec4 abs(Vec4 a) noexcept         { return Vec4(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)); }
+        static Vec4 sqrt(Vec4 a) noexcept        { return Vec4(_mm_sqrt_ps(a.v)); }
+
+        static Vec4 selectLess(Vec4 a, Vec4 b, Vec4 ifLess, Vec4 otherwise) noexcept
+        {
+            const __m128 mask = _mm_cmplt_ps(a.v, b.v);
+            return Vec4(_mm_or_ps(_mm_and_ps(mask, ifLess.v), _mm_andnot_ps(mask, otherwise.v)));
+        }
+    };
+
+   #if DELAYWAVE_SIMD_AVX
+    //==============================================================================
+    template <>
+    struct Vec4<double>
+    {
+        static constexpr int size = 4;
+
+        __m256d v;
+
+        Vec4() = default;
+        explicit Vec4(__m256d x) noexcept : v(x) {}
+        explicit Vec4(double x) noexcept : v(_mm256_set1_pd(x)) {}
+
+        static Vec4 fromValues(double a, double b, double c, double d) noexcept { return Vec4(_mm256_setr_pd(a, b, c, d)); }
+        static Vec4 load(const double* p) noexcept                          { return Vec4(_mm256_loadu_pd(p)); }
+        void store(double* p) const noexcept                                { _mm256_storeu_pd(p, v); }
+
+        double get(int lane) const noexcept
+        {
+            alignas(32) double tmp[size];
+            _mm256_store_pd(tmp, v);
+            return tmp[lane];
+        }
+
+        static Vec4 min(Vec4 a, Vec4 b) noexcept { return Vec4(_mm256_min_pd(a.v, b.v)); }
+        static Vec4 max(Vec4 a, Vec4 b) noexcept { return Vec4(_mm256_max_pd(a.v, b.v)); }
+        static Vec4 abs(Vec4 a) noexcept         { return Vec4(_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)); }
+        static Vec4 sqrt(Vec4 a) noexcept        { return Vec4(_mm256_sqrt_pd(a.v)); }
+
+        static Vec4 selectLess(Vec4 a, Vec4 b, Vec4 ifLess, Vec4 otherwise) noexcept
+        {
+            return Vec4(_mm256_blendv_pd(otherwise.v, ifLess.v, _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)));
+        }
+    };
+
+    // Not friends: GCC leaves friends defined in the class out of the
+    // variant's target switch
+    inline Vec4<double> operator+(Vec4<double> a, Vec4<double> b) noexcept { return Vec4<double>(_mm256_add_pd(a.v, b.v)); }
+    inline Vec4<double> operator-(Vec4<double> a, Vec4<double> b) noexcept { return Vec4<double>(_mm256_sub_pd(a.v, b.v)); }
+    inline Vec4<double> operator*(Vec4<double> a, Vec4<double> b) noexcept { return Vec4<double>(_mm256_mul_pd(a.v, b.v)); }
+    inline Vec4<double> operator/(Vec4<double> a, Vec4<double> b) noexcept { return Vec4<double>(_mm256_div_pd(a.v, b.v)); }
+   #else
+    //==============================================================================
+    template <>
+    struct Vec4<double>
+    {
+        static constexpr int size = 4;
+
+        __m128d lo, hi;
+
+        Vec4() = default;
+        Vec4(__m128d l, __m128d h) noexcept : lo(l), hi(h) {}
+        explicit Vec4(double x) noexcept : lo(_mm_set1_pd(x)), hi(_mm_set1_pd(x)) {}
+
+        static Vec4 fromValues(double a, double b, double c, double d) noexcept { return { _mm_setr_pd(a, b), _mm_setr_pd(c, d) }; }
+        static Vec4 load(const double* p) noexcept                          { return { _mm_loadu_pd(p), _mm_loadu_pd(p + 2) }; }
+        void store(double* p) const noexcept                                { _mm_storeu_pd(p, lo); _mm_storeu_pd(p + 2, hi); }
+
+        double get(int lane) const noexcept
+        {
+            alignas(16) double tmp[size];
+            _mm_store_pd(tmp, lo);
+            _mm_store_pd(tmp + 2, hi);
+            return tmp[lane];
+        }
+
+        friend Vec4 operator+(Vec4 a, Vec4 b) noexcept { return { _mm_add_pd(a.lo, b.lo), _mm_add_pd(a.hi, b.hi) }; }
+        friend Vec4 operator-(Vec4 a, Vec4 b) noexcept { return { _mm_sub_pd(a.lo, b.lo), _mm_sub_pd(a.hi, b.hi) }; }
+        friend Vec4 operator*(Vec4 a, Vec4 b) noexcept { return { _mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi) }; }
+        friend Vec4 operator/(Vec4 a, Vec4 b) noexcept { return { _mm_div_pd(a.lo, b.lo), _mm_div_pd(a.hi, b.hi) }; }
+
+        static Vec4 min(Vec4 a, Vec4 b) noexcept { return { _mm_min_pd(a.lo, b.lo), _mm_min_pd(a.hi, b.hi) }; }
+        static Vec4 max(Vec4 a, Vec4 b) noexcept { return { _mm_max_pd(a.lo, b.lo), _mm_max_pd(a.hi, b.hi) }; }
+        static Vec4 abs(Vec4 a) noexcept         { const __m128d sign = _mm_set1_pd(-0.0); return { _mm_andnot_pd(sign, a.lo), _mm_andnot_pd(sign, a.hi) }; }
+        static Vec4 sqrt(Vec4 a) noexcept        { return { _mm_sqrt_pd(a.lo), _mm_sqrt_pd(a.hi) }; }
+
+        static Vec4 selectLess(Vec4 a, Vec4 b, Vec4 ifLess, Vec4 otherwise) noexcept
+        {
+            const __m128d lo = _mm_cmplt_pd(a.lo, b.lo);
+            const __m128d hi = _mm_cmplt_pd(a.hi, b.hi);
+            return { _mm_or_pd(_mm_and_pd(lo, ifLess.lo), _mm_andnot_pd(lo, otherwise.lo)),
+                     _mm_or_pd(_mm_and_pd(hi, ifLess.hi), _mm_andnot_pd(hi, otherwise.hi)) };
+        }
+    };
+   #endif
+#elif DELAYWAVE_SIMD_NEON
+    //==============================================================================
+    template <>
+    struct Vec4<float>
+    {
+        static constexpr int size = 4;
+
+        float32x4_t v;
+
+        Vec4() = default;
+        explicit Vec4(float32x4_t x) noexcept : v(x) {}
+        explicit Vec4(float x) noexcept : v(vdupq_n_f32(x)) {}
+
+        static Vec4 fromValues(float a, float b, float c, float d) noexcept
+        {
+            const float tmp[size] = { a, b, c, d };
+            return Vec4(vld1q_f32(tmp));
+        }
+
+        static Vec4 load(const float* p) noexcept   { return Vec4(vld1q_f32(p)); }
+        void store(float* p) const noexcept         { vst1q_f32(p, v); }
+
+        float get(int lane) const noexcept
+        {
+            float tmp[size];
+            vst1q_f32(tmp, v);
+            return tmp[lane];
+        }
+
+        friend Vec4 operator+(Vec4 a, Vec4 b) noexcept { return Vec4(vaddq_f32(a.v, b.v)); }
+        friend Vec4 operator-(Vec4 a, Vec4 b) noexcept { return Vec4(vsubq_f32(a.v, b.v)); }
+        friend Vec4 operator*(Vec4 a, Vec4 b) noexcept { return Vec4(vmulq_f32(a.v, b.v)); }
+        friend Vec4 operator/(Vec4 a, Vec4 b) noexcept { return Vec4(vdivq_f32(a.v, b.v)); }
+
+        static Vec4 min(Vec4 a, Vec4 b) noexcept { return Vec4(vminq_f32(a.v, b.v)); }
+        static Vec4 max(Vec4 a, Vec4 b) noexcept { return Vec4(vmaxq_f32(a.v, b.v)); }
+        static Vec4 abs(Vec4 a) noexcept         { return Vec4(vabsq_f32(a.v)); }
+        static Vec4 sqrt(Vec4 a) noexcept        { return Vec4(vsqrtq_f32(a.v)); }
+
+        static Vec4 selectLess(Vec4 a, Vec4 b, Vec4 ifLess, Vec4 otherwise) noexcept
+        {
+            return Vec4(vbslq_f32(vcltq_f32(a.v, b.v), ifLess.v, otherwise.v));
+        }
+    };
+
+    //==============================================================================
+    template <>
+    struct Vec4<double>
+    {
+        static constexpr int size = 4;
+
+        float64x2_t lo, hi;
+
+        Vec4() = default;
+        Vec4(float64x2_t l, float64x2_t h) noexcept : lo(l), hi(h) {}
+        explicit Vec4(double x) noexcept : lo(vdupq_n_f64(x)), hi(vdupq_n_f64(x)) {}
+
+        static Vec4 fromValues(double a, double b, double c, double d) noexcept
+        {
+            const double tmp[size] = { a, b, c, d };
+            return load(tmp);
+        }
+
+        static Vec4 load(const double* p) noexcept  { return { vld1q_f64(p), vld1q_f64(p + 2) }; }
+        void store(double* p) const noexcept        { vst1q_f64(p, lo); vst1q_f64(p + 2, hi); }
+
+        double get(int lane) const noexcept
+        {
+            double tmp[size];
+            store(tmp);
+            return tmp[lane];
+        }
+
+        friend Vec4 operator+(Vec4 a, Vec4 b) noexcept { return { vaddq_f64(a.lo, b.lo), vaddq_f64(a.hi, b.hi) }; }
+        friend Vec4 operator-(Vec4 a, Vec4 b) noexcept { return { vsubq_f64(a.lo, b.lo), vsubq_f64(a.hi, b.hi) }; }
+        friend Vec4 operator*(Vec4 a, Vec4 b) noexcept { return { vmulq_f64(a.lo, b.lo), vmulq_f64(a.hi, b.hi) }; }
+        friend Vec4 operator/(Vec4 a, Vec4 b) noexcept { return { vdivq_f64(a.lo, b.lo), vdivq_f64(a.hi, b.hi) }; }
+
+        static Vec4 min(Vec4 a, Vec4 b) noexcept { return { vminq_f64(a.lo, b.lo), vminq_f64(a.hi, b.hi) }; }
+        static Vec4 max(Vec4 a, Vec4 b) noexcept { return { vmaxq_f64(a.lo, b.lo), vmaxq_f64(a.hi, b.hi) }; }
+        static Vec4 abs(Vec4 a) noexcept         { return { vabsq_f64(a.lo), vabsq_f64(a.hi) }; }
+        static Vec4 sqrt(Vec4 a) noexcept        { return { vsqrtq_f64(a.lo), vsqrtq_f64(a.hi) }; }
+
+        static Vec4 selectLess(Vec4 a, Vec4 b, Vec4 ifLess, Vec4 otherwise) noexcept
+        {
+            return { vbslq_f64(vcltq_f64(a.lo, b.lo), ifLess.lo, otherwise.lo),
+                     vbslq_f64(vcltq_f64(a.hi, b.hi), ifLess.hi, otherwise.hi) };
+        }
+    };
+#endif
+
+    //==============================================================================
+    // Lane access that works for plain scalars too, so kernels can be written
+    // once for float and Vec4<float>.
+    template <typename V> struct LaneCount              { static constexpr int value = 1; };
+    template <typename T> struct LaneCount<Vec4<T>>     { static constexpr int value = Vec4<T>::size; };
+
+    inline float getLane(float x, int) noexcept                     { return x; }
+    inline double getLane(double x, int) noexcept                   { return x; }
+    template <typename T> T getLane(const Vec4<T>& x, int lane) noexcept { return x.get(lane); }
+
+    // The same for the maths helpers
+    template <typename T> T vecMin(T a, T b) noexcept                 { return std::min(a, b); }
+    template <typename T> T vecMax(T a, T b) noexcept                 { return std::max(a, b); }
+    template <typename T> T vecAbs(T a) noexcept                      { return std::abs(a); }
+    template <typename T> T vecSqrt(T a) noexcept                     { return std::sqrt(a); }
+    template <typename T> T selectLess(T a, T b, T ifLess, T otherwise) noexcept { return a < b ? ifLess : otherwise; }
+
+    template <typename T> Vec4<T> vecMin(Vec4<T> a, Vec4<T> b) noexcept  { return Vec4<T>::min(a, b); }
+    template <typename T> Vec4<T> vecMax(Vec4<T> a, Vec4<T> b) noexcept  { return Vec4<T>::max(a, b); }
+    template <typename T> Vec4<T> vecAbs(Vec4<T> a) noexcept             { return Vec4<T>::abs(a); }
+    template <typename T> Vec4<T> vecSqrt(Vec4<T> a) noexcept            { return Vec4<T>::sqrt(a); }
+    template <typename T> Vec4<T> selectLess(Vec4<T> a, Vec4<T> b, Vec4<T> ifLess, Vec4<T> otherwise) noexcept
+    {
+        return Vec4<T>::selectLess(a, b, ifLess, otherwise);
+    }
+}
+}
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+    DelayWave - Smoothed Parameter Bank
+    Linear smoothing for a fixed set of parameters, rendered a block at a
+    time. A parameter only writes its ramp into the bank's contiguous
+    storage while it is actually moving; otherwise it is reported as a
+    constant so the audio kernels can take their steady-state path.
+
+    Parameters can also be smoothed at control rate: the value then moves
+    once every N samples and is held in between.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ControlSignal.h"
+#include "FloatCompare.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace DelayWaveDSP
+{
+    class SmoothedParameterBank
+    {
+    public:
+        static constexpr int maxParameters = 16;
+
+        //==============================================================================
+        void prepare(double newSampleRate, int maxBlockSizeToUse, int numParametersToUse, double rampSeconds = 0.02)
+        {
+            sampleRate = newSampleRate;
+            maxBlockSize = std::max(1, maxBlockSizeToUse);
+            numParameters = std::clamp(numParametersToUse, 0, maxParameters);
+            ramps.assign(static_cast<size_t>(maxBlockSize * numParameters), 0.0f);
+
+            for (int i = 0; i < numParameters; ++i)
+            {
+                params[i] = {};
+                params[i].rampSeconds = rampSeconds;
+                updateRampSteps(params[i]);
+            }
+        }
+
+        // Smoothing time for one parameter
+        void setRampLength(int index, double seconds)
+        {
+            params[index].rampSeconds = seconds;
+            updateRampSteps(params[index]);
+        }
+
+        // Update the parameter every intervalSamples instead of every sample
+        void setControlInterval(int index, int intervalSamples)
+        {
+            params[index].interval = std::max(1, intervalSamples);
+            updateRampSteps(params[index]);
+        }
+
+        //==============================================================================
+        void setCurrentAndTargetValue(int index, float value) noexcept
+        {
+            auto& p = params[index];
+            p.current = p.target = value;
+            p.countdown = 0;
+        }
+
+        void setTargetValue(int index, float value) noexcept
+        {
+            auto& p = params[index];
+
+            if (exactlyEqual(value, p.target))
+                return;
+
+            if (p.rampSteps <= 0)
+            {
+                setCurrentAndTargetValue(index, value);
+                return;
+            }
+
+            p.target = value;
+            p.countdown = p.rampSteps;
+            p.step = (p.target - p.current) / static_cast<float>(p.countdown);
+            p.samplesToNextUpdate = 0;
+        }
+
+        float getCurrentValue(int index) const noexcept { return params[index].current; }
+        size_t getMemoryUsageBytes() const noexcept { return ramps.capacity() * sizeof(float); }
+        bool isSmoothing(int index) const noexcept { return params[index].countdown > 0; }
+
+        //==============================================================================
+        // Advances every parameter by numSamples (at most the prepared block
+        // size) and writes ramps for the ones that are moving.
+        void process(int numSamples) noexcept
+        {
+            numSamples = std::min(numSamples, maxBlockSize);
+            anyRamping = false;
+
+            for (int index = 0; index < numParameters; ++index)
+            {
+                auto& p = params[index];
+                p.rampedThisBlock = p.countdown > 0;
+
+                if (! p.rampedThisBlock)
+                    continue;
+
+                anyRamping = true;
+                float* out = ramps.data() + index * maxBlockSize;
+
+                if (p.interval == 1)
+                {
+                    for (int i = 0; i < numSamples; ++i)
+                    {
+                        if (p.countdown > 0)
+                            advance(p);
+
+                        out[i] = p.current;
+                    }
+                }
+                else
+                {
+                    // Control rate: one step per interval, held in between
+                    for (int i = 0; i < numSamples;)
+                    {
+                        if (p.samplesToNextUpdate == 0)
+                        {
+                            if (p.countdown > 0)
+                                advance(p);
+
+                            p.samplesToNextUpdate = p.interval;
+                        }
+
+                        const int run = std::min(p.samplesToNextUpdate, numSamples - i);
+                        std::fill(out + i, out + i + run, p.current);
+                        p.samplesToNextUpdate -= run;
+                        i += run;
+                    }
+                }
+            }
+        }
+
+        // True when no parameter moved during the last process() call
+        bool isBlockConstant() const noexcept { return ! anyRamping; }
+
+        // The parameter's values for the last processed block
+        ControlSignal get(int index) const noexcept
+        {
+            const auto& p = params[index];
+
+            if (p.rampedThisBlock)
+                return { ramps.data() + index * maxBlockSize, p.current };
+
+            return ControlSignal::constant(p.current);
+        }
+
+    private:
+        //==============================================================================
+        struct Parameter
+        {
+            float current = 0.0f;
+            float target = 0.0f;
+            float step = 0.0f;
+            int countdown = 0;              // Control steps left in the current ramp
+            int rampSteps = 0;              // Control steps in a full ramp
+            int interval = 1;               // Samples per control step
+            int samplesToNextUpdate = 0;
+            double rampSeconds = 0.02;
+            bool rampedThisBlock = false;
+        };
+
+        void updateRampSteps(Parameter& p) const noexcept
+        {
+            p.rampSteps = static_cast<int>(std::floor(p.rampSeconds * sampleRate / p.interval));
+        }
+
+        static void advance(Parameter& p) noexcept
+        {
+            --p.countdown;
+            p.current = p.countdown > 0 ? p.current + p.step : p.target;
+        }
+
+        //==============================================================================
+        Parameter params[maxParameters];
+        std::vector<float> ramps;   // maxBlockSize values per parameter
+        double sampleRate = 44100.0;
+        int maxBlockSize = 0;
+        int numParameters = 0;
+        bool anyRamping = false;
+    };
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+    DelayWave - Tempo Sync
+    Note divisions for host-synced delay times, and a transport follower
+    that tells the processor when the host position no longer continues
+    from the previous block (start, loop or locate), so the LFO can be
+    re-locked to the timeline.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace DelayWaveDSP
+{
+    namespace TempoSync
+    {
+        // Division names in parameter order
+        inline constexpr std::array<const char*, 16> divisionNames {
+            "1/32", "1/16T", "1/16", "1/16D",
+            "1/8T", "1/8", "1/8D",
+            "1/4T", "1/4", "1/4D",
+            "1/2T", "1/2", "1/2D",
+            "1/1T", "1/1", "1/1D"
+        };
+
+        inline constexpr int defaultDivision = 8;   // 1/4
+
+        // Slowest tempo synced times follow; below it they stay at this
+        // tempo's lengths, so a host reporting no tempo cannot divide by zero
+        inline constexpr double minBpm = 40.0;
+
+        // Length of a division in quarter notes
+        inline double divisionToBeats(int index) noexcept
+        {
+            constexpr std::array<double, divisionNames.size()> beats {
+                0.125,
+                0.25 * 2.0 / 3.0, 0.25, 0.375,
+                0.5 * 2.0 / 3.0, 0.5, 0.75,
+                2.0 / 3.0, 1.0, 1.5,
+                2.0 * 2.0 / 3.0, 2.0, 3.0,
+                4.0 * 2.0 / 3.0, 4.0, 6.0
+            };
+
+            if (index < 0 || index >= static_cast<int>(beats.size()))
+                index = defaultDivision;
+
+            return beats[static_cast<size_t>(index)];
+        }
+
+        inline double divisionToMs(int index, double bpm) noexcept
+        {
+            return divisionToBeats(index) * 60000.0 / std::max(bpm, minBpm);
+        }
+    }
+
+    //==============================================================================
+    // Tracks the host timeline once per block. update() returns true when the
+    // position is not where the previous block left off, which is when any
+    // state locked to the timeline needs to be re-derived.
+    class TransportFollower
+    {
+    public:
+        void reset() noexcept { hasPosition = false; }
+
+        bool update(bool isPlaying, double ppqPosition, double bpm, int numSamples, double sampleRate) noexcept
+        {
+            if (! isPlaying)
+            {
+                hasPosition = false;
+                return false;
+            }
+
+            // Allow a little slack for hosts that round the reported position
+            const bool jumped = ! hasPosition || std::abs(ppqPosition - expectedPpq) > 1.0e-3;
+
+            expectedPpq = ppqPosition + numSamples * bpm / (60.0 * sampleRate);
+            hasPosition = true;
+            return jumped;
+        }
+
+    private:
+        double expectedPpq = 0.0;
+        bool hasPosition = false;
+    };
+}
@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+    DelayWave - Tone Filter
+    Lowpass (and optional highpass) for the feedback loop, built from TPT
+    state-variable stages so the response is set in Hz and stays the same
+    at every sample rate. One stage gives 12 dB/oct, two stages a 24 dB/oct
+    Butterworth.
+
+    Coefficients are computed once per block from the target frequencies
+    and interpolated linearly across the block, so no trigonometry runs per
+    sample. The state is kept per lane and is processed as a vector, one
+    lane per channel.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayParams.h"
+#include "FloatCompare.h"
+#include "SimdVec.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace DelayWaveDSP
+{
+inline namespace DELAYWAVE_ISA
+{
+    //==============================================================================
+    template <typename SampleType>
+    class ToneFilter
+    {
+    public:
+        static constexpr int maxStagesPerFilter = 2;
+        static constexpr int maxStages = maxStagesPerFilter * 2;
+        static constexpr int numLanes = DelayBlockParams::numLanes;
+        static constexpr int numStateSlots = maxStages * 2;
+
+        //==============================================================================
+        void prepare(double newSampleRate)
+        {
+            sampleRate = newSampleRate;
+            hasTarget = false;
+            reset();
+        }
+
+        void reset()
+        {
+            for (auto& slot : state)
+                std::fill(std::begin(slot), std::end(slot), SampleType(0));
+        }
+
+        // Sets the frequencies to reach by the end of the next numSamples.
+        // The first call after prepare(), and any change in the number of
+        // stages, jumps straight to the new response.
+        void setTarget(const ToneSettings& settings, int numSamples) noexcept
+        {
+            const int slope = std::clamp(settings.slope, 1, maxStagesPerFilter);
+            const int newLowpass = slope;
+            const int newHighpass = settings.highpassHz > 0.0f ? slope : 0;
+
+            Coefficients newTarget[maxStages];
+            for (int s = 0; s < newLowpass; ++s)
+                newTarget[s] = design(settings.lowpassHz, stageDamping(slope, s));
+
+            for (int s = 0; s < newHighpass; ++s)
+                newTarget[newLowpass + s] = design(settings.highpassHz, stageDamping(slope, s));
+
+            const bool layoutChanged = newLowpass != numLowpass || newHighpass != numHighpass;
+
+            // Stages that were not running start from silence
+            if (layoutChanged)
+                for (int slot = 2 * (numLowpass + numHighpass); slot < numStateSlots; ++slot)
+                    std::fill(std::begin(state[slot]), std::end(state[slot]), SampleType(0));
+
+            numLowpass = newLowpass;
+            numHighpass = newHighpass;
+            ramping = false;
+
+            const SampleType scale = SampleType(1) / static_cast<SampleType>(std::max(1, numSamples));
+
+            for (int s = 0; s < getNumStages(); ++s)
+            {
+                const auto& from = hasTarget && ! layoutChanged ? target[s] : newTarget[s];
+
+                start[s] = from;
+                step[s] = { (newTarget[s].a1 - from.a1) * scale,
+                            (newTarget[s].a2 - from.a2) * scale,
+                            (newTarget[s].a3 - from.a3) * scale,
+                            (newTarget[s].k - from.k) * scale };
+                target[s] = newTarget[s];
+
+                ramping = ramping || ! isZero(step[s]);
+            }
+
+            hasTarget = true;
+        }
+
+        bool isRamping() const noexcept { return ramping; }
+        int getNumStages() const noexcept { return numLowpass + numHighpass; }
+
+        //==============================================================================
+        // Filters one sample at block position i. V is SampleType (one lane)
+        // or Vec4<SampleType> (all lanes); states holds two entries per
+        // stage, loaded with loadState() and written back with storeState().
+        template <typename V, bool Ramping>
+        V process(V x, V* states, int i) const noexcept
+        {
+            int s = 0;
+
+            for (; s < numLowpass; ++s)
+                x = runStage<V, Ramping, false>(x, states[2 * s], states[2 * s + 1], s, i);
+
+            for (; s < numLowpass + numHighpass; ++s)
+                x = runStage<V, Ramping, true>(x, states[2 * s], states[2 * s + 1], s, i);
+
+            return x;
+        }
+
+        void loadState(SampleType* states, int lane) const noexcept
+        {
+            for (int slot = 0; slot < 2 * getNumStages(); ++slot)
+                states[slot] = state[slot][lane];
+        }
+
+        void storeState(const SampleType* states, int lane) noexcept
+        {
+            for (int slot = 0; slot < 2 * getNumStages(); ++slot)
+                state[slot][lane] = states[slot];
+        }
+
+        void loadState(Vec4<SampleType>* states) const noexcept
+        {
+            for (int slot = 0; slot < 2 * getNumStages(); ++slot)
+                states[slot] = Vec4<SampleType>::load(state[slot]);
+        }
+
+        void storeState(const Vec4<SampleType>* states) noexcept
+        {
+            for (int slot = 0; slot < 2 * getNumStages(); ++slot)
+                states[slot].store(state[slot]);
+        }
+
+    private:
+        //==============================================================================
+        struct Coefficients
+        {
+            SampleType a1 = 1, a2 = 0, a3 = 0, k = 0;
+        };
+
+        static bool isZero(const Coefficients& c) noexcept
+        {
+            const SampleType zero(0);
+            return exactlyEqual(c.a1, zero) && exactlyEqual(c.a2, zero) && exactlyEqual(c.a3, zero) && exactlyEqual(c.k, zero);
+        }
+
+        // Damping (1/Q) of each stage for a Butterworth response
+        static double stageDamping(int slope, int stage) noexcept
+        {
+            if (slope == 1)
+                return 1.4142135623730951;
+
+            return stage == 0 ? 1.8477590650225735 : 0.7653668647301797;
+        }
+
+        Coefficients design(float hz, double damping) const noexcept
+        {
+            const double fc = std::clamp(static_cast<double>(hz), 10.0, sampleRate * 0.45);
+            const double g = std::tan(3.141592653589793 * fc / sampleRate);
+            const double a1 = 1.0 / (1.0 + g * (g + damping));
+            const double a2 = g * a1;
+
+            return { static_cast<SampleType>(a1), static_cast<SampleType>(a2),
+                     static_cast<SampleType>(g * a2), static_cast<SampleType>(damping) };
+        }
+
+        template <bool Ramping>
+        Coefficients coefficientsAt(int stage, int i) const noexcept
+        {
+            if constexpr (Ramping)
+            {
+                const auto n = static_cast<SampleType>(i + 1);
+                const auto& a = start[stage];
+                const auto& d = step[stage];
+                return { a.a1 + d.a1 * n, a.a2 + d.a2 * n, a.a3 + d.a3 * n, a.k + d.k * n };
+            }
+            else
+            {
+                return target[stage];
+            }
+        }
+
+        // One TPT state-variable stage (trapezoidal integrators)
+        template <typename V, bool Ramping, bool Highpass>
+        V runStage(V v0, V& ic1, V& ic2, int stage, int i) const noexcept
+        {
+            const auto c = coefficientsAt<Ramping>(stage, i);
+
+            const V v3 = v0 - ic2;
+            const V v1 = V(c.a1) * ic1 + V(c.a2) * v3;
+            const V v2 = ic2 + V(c.a2) * ic1 + V(c.a3) * v3;
+
+            ic1 = V(SampleType(2)) * v1 - ic1;
+            ic2 = V(SampleType(2)) * v2 - ic2;
+
+            if constexpr (Highpass)
+                return v0 - V(c.k) * v1 - v2;
+            else
+                return v2;
+        }
+
+        //==============================================================================
+        double sampleRate = 44100.0;
+        int numLowpass = 0;
+        int numHighpass = 0;
+        bool hasTarget = false;
+        bool ramping = false;
+
+        Coefficients start[maxStages], step[maxStages], target[maxStages];
+        SampleType state[numStateSlots][numLanes] {};
+    };
+}
+}
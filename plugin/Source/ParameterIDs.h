@@ -15,14 +15,60 @@ namespace ParamIDs
     inline constexpr const char* time     = "time";      // Delay time in ms
     inline constexpr const char* feedback = "feedback";  // Feedback amount 0-1
     inline constexpr const char* mix      = "mix";       // Dry/wet mix 0-1
+    inline constexpr const char* feedbackMode = "feedbackMode";  // Stereo, Ping-Pong, Diffuse
+    inline constexpr const char* timeMode = "timeMode";          // Tape (glide) or Jump (crossfade) on time changes
+
+    // Mid/side (stereo only)
+    inline constexpr const char* midSide      = "midSide";       // Process the stereo pair as mid and side
+    inline constexpr const char* sideTime     = "sideTime";      // Delay time of the side channel in ms
+    inline constexpr const char* sideFeedback = "sideFeedback";  // Feedback of the side channel 0-1
+
+    // Tempo sync
+    inline constexpr const char* sync         = "sync";          // Delay time follows host tempo
+    inline constexpr const char* syncDivision = "syncDivision";  // Note division when synced
+
+    // Multi-tap
+    inline constexpr const char* taps      = "taps";       // Read heads per channel 1-8 (1 = single delay)
+    inline constexpr const char* tapDecay  = "tapDecay";   // Level drop from tap to tap 0-1
+    inline constexpr const char* tapSpread = "tapSpread";  // Stereo spread of the extra taps 0-1
 
     // Modulation (the wavey stuff!)
     inline constexpr const char* modRate  = "modRate";   // LFO rate in Hz
     inline constexpr const char* modDepth = "modDepth";  // Modulation depth 0-1
+    inline constexpr const char* modShape = "modShape";  // LFO shape (Sine, Triangle, Random, S&H)
+    inline constexpr const char* modPhase = "modPhase";  // LFO phase spread across channels in degrees
+
+    // Modulation matrix sources
+    inline constexpr const char* lfo2Rate   = "lfo2Rate";    // Second LFO rate in Hz
+    inline constexpr const char* lfo2Shape  = "lfo2Shape";   // Sine, Triangle, Random, S&H
+    inline constexpr const char* envAttack  = "envAttack";   // Envelope follower attack in ms
+    inline constexpr const char* envRelease = "envRelease";  // Envelope follower release in ms
+    inline constexpr const char* randomRate = "randomRate";  // Smooth random rate in Hz
+
+    // Modulation matrix routings, one source, destination and amount per slot
+    inline constexpr int numModSlots = 4;
+    inline constexpr const char* modSource[numModSlots]      = { "mod1Source", "mod2Source", "mod3Source", "mod4Source" };
+    inline constexpr const char* modDestination[numModSlots] = { "mod1Dest", "mod2Dest", "mod3Dest", "mod4Dest" };
+    inline constexpr const char* modAmount[numModSlots]      = { "mod1Amount", "mod2Amount", "mod3Amount", "mod4Amount" };
 
     // Tone control
-    inline constexpr const char* tone     = "tone";      // Filter brightness 0-1
+    inline constexpr const char* tone      = "tone";       // Filter brightness 0-1 (lowpass cutoff)
+    inline constexpr const char* toneSlope = "toneSlope";  // 12 or 24 dB/oct
+    inline constexpr const char* lowCut    = "lowCut";     // Highpass in the repeats, Hz (20 = off)
+
+    // Saturation in the feedback loop
+    inline constexpr const char* saturation     = "saturation";      // Drive in dB
+    inline constexpr const char* saturationMode = "saturationMode";  // Off, Tanh, Tape, Hard Clip
+
+    // Allpass diffusion in the feedback loop
+    inline constexpr const char* diffusion       = "diffusion";        // Amount 0-1 (0 = off)
+    inline constexpr const char* diffusionStages = "diffusionStages";  // Allpass stages 4-8
+
+    // Quality
+    inline constexpr const char* oversampling       = "oversampling";        // 1x, 2x, 4x
+    inline constexpr const char* oversamplingFilter = "oversamplingFilter";  // IIR, FIR
 
     // Bypass
-    inline constexpr const char* bypass   = "bypass";
+    inline constexpr const char* bypass     = "bypass";
+    inline constexpr const char* bypassTail = "bypassTail";  // Stop, Ring Out
 }
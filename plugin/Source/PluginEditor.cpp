@@ -37,6 +37,7 @@ DelayWaveEditor::DelayWaveEditor(DelayWaveProcessor& p)
 DelayWaveEditor::~DelayWaveEditor()
 {
     stopTimer();
+    processorRef.getCpuLoadMeter().setEnabled(false);
 }
 
 //==============================================================================
@@ -117,6 +118,14 @@ void DelayWaveEditor::setupWebView()
         .withEventListener("activate", [this](const juce::var& params) {
             handleActivate(params);
         })
+        // Performance panel
+        .withEventListener("setPerformanceMonitoring", [this](const juce::var& params) {
+            const bool enabled = params.getProperty("enabled", false);
+            processorRef.getCpuLoadMeter().setEnabled(enabled);
+            performanceTicks = 0;
+            lastPerformanceWindow = 0;
+            totalOverruns = 0;
+        })
         .withWinWebView2Options(
             juce::WebBrowserComponent::Options::WinWebView2()
                 .withBackgroundColour(juce::Colour(0xff0f0f12))
@@ -161,6 +170,7 @@ void DelayWaveEditor::setupRelaysAndAttachments()
 void DelayWaveEditor::timerCallback()
 {
     sendVisualizerData();
+    sendPerformanceData();
     sendActivationState();
 }
 
@@ -175,6 +185,39 @@ void DelayWaveEditor::sendVisualizerData()
     webView->emitEventIfBrowserIsVisible("visualizerData", juce::var(data.get()));
 }
 
+void DelayWaveEditor::sendPerformanceData()
+{
+    auto& meter = processorRef.getCpuLoadMeter();
+    if (!webView || !meter.isEnabled() || ++performanceTicks < performanceWindowTicks)
+        return;
+
+    performanceTicks = 0;
+
+    // The window ended by the previous request; without audio running no
+    // new one completes, and nothing is sent twice
+    const auto snapshot = meter.getSnapshot();
+    meter.requestWindow();
+
+    if (snapshot.window == lastPerformanceWindow)
+        return;
+
+    lastPerformanceWindow = snapshot.window;
+    totalOverruns += snapshot.numOverruns;
+
+    // Loads as a percentage of the block deadline
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("blocks", static_cast<int>(snapshot.numBlocks));
+    data->setProperty("minLoad", snapshot.minLoad * 100.0f);
+    data->setProperty("meanLoad", snapshot.meanLoad * 100.0f);
+    data->setProperty("p99Load", snapshot.p99Load * 100.0f);
+    data->setProperty("maxLoad", snapshot.maxLoad * 100.0f);
+    data->setProperty("overruns", static_cast<int>(snapshot.numOverruns));
+    data->setProperty("totalOverruns", static_cast<juce::int64>(totalOverruns));
+    data->setProperty("counter", DelayWaveDSP::getCycleCounterName());
+    data->setProperty("kernel", processorRef.getKernelInstructionSetName());
+    webView->emitEventIfBrowserIsVisible("performance", juce::var(data.get()));
+}
+
 //==============================================================================
 void DelayWaveEditor::setupActivationEvents()
 {
@@ -58,10 +58,20 @@ private:
     void setupRelaysAndAttachments();
     void setupActivationEvents();
     void sendVisualizerData();
+    void sendPerformanceData();
     void sendActivationState();
     void handleActivate(const juce::var& params);
     void sendActivationResult(bool success, const juce::String& status, const juce::String& message);
 
+    //==============================================================================
+    // Performance panel: CPU load is measured while the panel is open, in
+    // windows of performanceWindowTicks timer ticks; each tick that ends a
+    // window sends the one completed before it
+    static constexpr int performanceWindowTicks = 15;
+    int performanceTicks = 0;
+    juce::uint32 lastPerformanceWindow = 0;
+    juce::uint64 totalOverruns = 0;
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DelayWaveEditor)
 };
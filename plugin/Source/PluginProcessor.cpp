@@ -6,9 +6,12 @@
 */
 
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
 #include "ParameterIDs.h"
 
+#if ! DELAYWAVE_HEADLESS
+#include "PluginEditor.h"
+#endif
+
 #if HAS_PROJECT_DATA
 #include "ProjectData.h"
 #endif
@@ -25,15 +28,22 @@ DelayWaveProcessor::DelayWaveProcessor()
     : AudioProcessor(BusesProperties()
                      .withInput("Input", juce::AudioChannelSet::stereo(), true)
                      .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts(*this, nullptr, "Parameters", createParameterLayout()),
-      delayLineL(static_cast<int>(maxDelaySeconds * 192000)),  // Max sample rate headroom
-      delayLineR(static_cast<int>(maxDelaySeconds * 192000))
+      apvts(*this, nullptr, "Parameters", createParameterLayout())
 {
     loadProjectData();
+
+    DBG("DSP kernels: " + juce::String(getKernelInstructionSetName()) + " (CPU supports "
+        + juce::String(DelayWaveDSP::getInstructionSetName(DelayWaveDSP::getCpuInstructionSet())) + ")");
+
+    // Oversampling changes wait for the next prepareToPlay (see parameterChanged)
+    apvts.addParameterListener(ParamIDs::oversampling, this);
+    apvts.addParameterListener(ParamIDs::oversamplingFilter, this);
 }
 
 DelayWaveProcessor::~DelayWaveProcessor()
 {
+    apvts.removeParameterListener(ParamIDs::oversampling, this);
+    apvts.removeParameterListener(ParamIDs::oversamplingFilter, this);
 }
 
 //==============================================================================
@@ -71,6 +81,95 @@ juce::AudioProcessorValueTreeState::ParameterLayout DelayWaveProcessor::createPa
             .withLabel("%")
     ));
 
+    // Feedback Mode: how the repeats are routed between channels
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::feedbackMode, 1 },
+        "Feedback Mode",
+        juce::StringArray { "Stereo", "Ping-Pong", "Diffuse" },
+        0
+    ));
+
+    // Time Mode: Tape glides to a new time (bending the pitch on the way),
+    // Jump crossfades to it
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::timeMode, 1 },
+        "Time Mode",
+        juce::StringArray { "Tape", "Jump" },
+        0
+    ));
+
+    // Mid/Side: a stereo bus is delayed as mid and side, the time and
+    // feedback above applying to the mid
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { ParamIDs::midSide, 1 },
+        "Mid/Side",
+        false
+    ));
+
+    // Side Time: delay of the side channel in Mid/Side (not tempo synced)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::sideTime, 1 },
+        "Side Time",
+        juce::NormalisableRange<float>(10.0f, 1000.0f, 1.0f, 0.5f),
+        450.0f,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("ms")
+    ));
+
+    // Side Feedback: feedback of the side channel in Mid/Side
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::sideFeedback, 1 },
+        "Side Feedback",
+        juce::NormalisableRange<float>(0.0f, 0.95f, 0.01f),
+        0.4f,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("%")
+    ));
+
+    // Sync: delay time from host tempo instead of milliseconds
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { ParamIDs::sync, 1 },
+        "Sync",
+        false
+    ));
+
+    // Sync Division: straight, triplet and dotted notes
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::syncDivision, 1 },
+        "Sync Division",
+        juce::StringArray(DelayWaveDSP::TempoSync::divisionNames.data(),
+                          static_cast<int>(DelayWaveDSP::TempoSync::divisionNames.size())),
+        DelayWaveDSP::TempoSync::defaultDivision
+    ));
+
+    // Taps: extra read heads evenly spaced before the main delay time
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID { ParamIDs::taps, 1 },
+        "Taps",
+        1, DelayWaveDSP::TapLayout::maxTaps,
+        1
+    ));
+
+    // Tap Decay: 0% (all taps equal) to 100% (steep fade)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::tapDecay, 1 },
+        "Tap Decay",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
+        0.3f,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("%")
+    ));
+
+    // Tap Spread: 0% (centred) to 100% (taps alternate hard left/right)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::tapSpread, 1 },
+        "Tap Spread",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
+        0.5f,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("%")
+    ));
+
     // Mod Rate: 0.1 Hz to 10 Hz
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID { ParamIDs::modRate, 1 },
@@ -91,6 +190,97 @@ juce::AudioProcessorValueTreeState::ParameterLayout DelayWaveProcessor::createPa
             .withLabel("%")
     ));
 
+    // Mod Shape: LFO waveform
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::modShape, 1 },
+        "Mod Shape",
+        juce::StringArray { "Sine", "Triangle", "Random", "S&H" },
+        0
+    ));
+
+    // Mod Phase: 0 to 180 degrees of LFO spread from the first to the last channel
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::modPhase, 1 },
+        "Mod Phase",
+        juce::NormalisableRange<float>(0.0f, 180.0f, 1.0f),
+        180.0f,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("deg")
+    ));
+
+    // LFO 2: a second modulation source for the matrix
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::lfo2Rate, 1 },
+        "LFO 2 Rate",
+        juce::NormalisableRange<float>(0.01f, 10.0f, 0.01f, 0.4f),
+        0.3f,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("Hz")
+    ));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::lfo2Shape, 1 },
+        "LFO 2 Shape",
+        juce::StringArray { "Sine", "Triangle", "Random", "S&H" },
+        0
+    ));
+
+    // Envelope follower on the input
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::envAttack, 1 },
+        "Env Attack",
+        juce::NormalisableRange<float>(1.0f, 500.0f, 1.0f, 0.4f),
+        10.0f,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("ms")
+    ));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::envRelease, 1 },
+        "Env Release",
+        juce::NormalisableRange<float>(10.0f, 2000.0f, 1.0f, 0.4f),
+        200.0f,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("ms")
+    ));
+
+    // Smooth random source
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::randomRate, 1 },
+        "Random Rate",
+        juce::NormalisableRange<float>(0.01f, 10.0f, 0.01f, 0.4f),
+        1.0f,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("Hz")
+    ));
+
+    // Modulation matrix slots: source, destination and a bipolar amount
+    for (int slot = 0; slot < ParamIDs::numModSlots; ++slot)
+    {
+        const juce::String name = "Mod " + juce::String(slot + 1);
+
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID { ParamIDs::modSource[slot], 1 },
+            name + " Source",
+            juce::StringArray { "Off", "LFO 1", "LFO 2", "Envelope", "Random" },
+            0
+        ));
+
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID { ParamIDs::modDestination[slot], 1 },
+            name + " Destination",
+            juce::StringArray { "Time", "Feedback", "Tone", "Mix", "Pan" },
+            0
+        ));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID { ParamIDs::modAmount[slot], 1 },
+            name + " Amount",
+            juce::NormalisableRange<float>(-1.0f, 1.0f, 0.01f),
+            0.0f
+        ));
+    }
+
     // Tone: 0% (dark) to 100% (bright)
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID { ParamIDs::tone, 1 },
@@ -101,6 +291,77 @@ juce::AudioProcessorValueTreeState::ParameterLayout DelayWaveProcessor::createPa
             .withLabel("%")
     ));
 
+    // Tone Slope: 12 or 24 dB/oct for the tone and low cut filters
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::toneSlope, 1 },
+        "Tone Slope",
+        juce::StringArray { "12 dB", "24 dB" },
+        0
+    ));
+
+    // Low Cut: highpass in the repeats, off at the bottom of the range
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::lowCut, 1 },
+        "Low Cut",
+        juce::NormalisableRange<float>(lowCutOffHz, 2000.0f, 1.0f, 0.3f),
+        lowCutOffHz,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("Hz")
+    ));
+
+    // Saturation curve for everything written into the delay line
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::saturationMode, 1 },
+        "Saturation",
+        juce::StringArray { "Off", "Tanh", "Tape", "Hard Clip" },
+        0
+    ));
+
+    // Drive into the saturator; small signals keep unity gain
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::saturation, 1 },
+        "Drive",
+        juce::NormalisableRange<float>(0.0f, 24.0f, 0.1f),
+        6.0f,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("dB")
+    ));
+
+    // Diffusion: allpass stages in the feedback loop blur the repeats into a wash
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::diffusion, 1 },
+        "Diffusion",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
+        0.0f,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("%")
+    ));
+
+    // Diffusion Stages: more stages smear further
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID { ParamIDs::diffusionStages, 1 },
+        "Diffusion Stages",
+        DelayWaveDSP::DiffusionSettings::minStages, DelayWaveDSP::DiffusionSettings::maxStages,
+        6
+    ));
+
+    // Oversampling for the delay core (reduces modulation aliasing, adds
+    // latency). Changes apply when the host next prepares the plugin.
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::oversampling, 1 },
+        "Oversampling",
+        juce::StringArray { "1x", "2x", "4x" },
+        0
+    ));
+
+    // Oversampling filter: polyphase IIR (low latency) or FIR (linear phase)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::oversamplingFilter, 1 },
+        "Oversampling Filter",
+        juce::StringArray { "IIR", "FIR" },
+        0
+    ));
+
     // Bypass
     params.push_back(std::make_unique<juce::AudioParameterBool>(
         juce::ParameterID { ParamIDs::bypass, 1 },
@@ -108,6 +369,14 @@ juce::AudioProcessorValueTreeState::ParameterLayout DelayWaveProcessor::createPa
         false
     ));
 
+    // Bypass Tail: cut the repeats with the bypass, or let them ring out
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { ParamIDs::bypassTail, 1 },
+        "Bypass Tail",
+        juce::StringArray { "Stop", "Ring Out" },
+        0
+    ));
+
     return { params.begin(), params.end() };
 }
 
@@ -123,8 +392,59 @@ bool DelayWaveProcessor::isMidiEffect() const { return false; }
 
 double DelayWaveProcessor::getTailLengthSeconds() const
 {
-    // Tail length depends on delay time and feedback
-    return maxDelaySeconds * 2.0;
+    // Repeats at the current delay time (plus the full modulation range,
+    // up to the end of the ring) until the feedback has brought them down
+    // to the silence threshold.
+    // Saturation and the tone filter only make the real tail shorter;
+    // diffusion spreads each repeat a little later. In mid/side the mid
+    // and side run at their own times and feedback; the longer tail wins.
+    const bool diffused = apvts.getRawParameterValue(ParamIDs::diffusion)->load() > 0.0f;
+
+    // Matrix modulation can stretch the time and raise the feedback by its
+    // full range, so the tail allows for the worst case
+    const auto isModulated = [this] (DelayWaveDSP::ModDestination destination)
+    {
+        for (int slot = 0; slot < ParamIDs::numModSlots; ++slot)
+        {
+            const auto source = static_cast<DelayWaveDSP::ModSource>(
+                static_cast<int>(apvts.getRawParameterValue(ParamIDs::modSource[slot])->load()));
+            const auto target = static_cast<DelayWaveDSP::ModDestination>(
+                static_cast<int>(apvts.getRawParameterValue(ParamIDs::modDestination[slot])->load()));
+            const float amount = apvts.getRawParameterValue(ParamIDs::modAmount[slot])->load();
+
+            if (source != DelayWaveDSP::ModSource::Off && target == destination && std::abs(amount) > 0.0f)
+                return true;
+        }
+
+        return false;
+    };
+
+    const double timeScale = isModulated(DelayWaveDSP::ModDestination::Time) ? 1.0 + modTimeRange : 1.0;
+    const double feedbackBoost = isModulated(DelayWaveDSP::ModDestination::Feedback) ? modFeedbackRange : 0.0;
+    const double maxFeedback = apvts.getParameterRange(ParamIDs::feedback).end;
+    const double longestTimeMs = getLongestDelayTimeMs();
+
+    const auto getTail = [=] (double timeMs, double feedbackSetting)
+    {
+        const double repeatSeconds = juce::jmin(timeMs * timeScale, longestTimeMs) / 1000.0
+                                   + maxModulationSeconds + (diffused ? diffusionTailSeconds : 0.0);
+        const double feedback = juce::jmin(feedbackSetting + feedbackBoost, maxFeedback);
+
+        if (feedback <= 0.0)
+            return repeatSeconds;
+
+        const double repeats = std::ceil(std::log(static_cast<double>(DelayWaveDSP::SilenceDetector::defaultThreshold))
+                                         / std::log(juce::jmin(feedback, 0.999)));
+        return repeatSeconds * (1.0 + repeats);
+    };
+
+    const double tail = getTail(getTargetDelayTimeMs(), apvts.getRawParameterValue(ParamIDs::feedback)->load());
+
+    if (getTotalNumInputChannels() != 2 || apvts.getRawParameterValue(ParamIDs::midSide)->load() < 0.5f)
+        return tail;
+
+    return juce::jmax(tail, getTail(apvts.getRawParameterValue(ParamIDs::sideTime)->load(),
+                                    apvts.getRawParameterValue(ParamIDs::sideFeedback)->load()));
 }
 
 int DelayWaveProcessor::getNumPrograms() { return 1; }
@@ -134,58 +454,229 @@ const juce::String DelayWaveProcessor::getProgramName(int index) { juce::ignoreU
 void DelayWaveProcessor::changeProgramName(int index, const juce::String& newName) { juce::ignoreUnused(index, newName); }
 
 //==============================================================================
-void DelayWaveProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+// Tone 0-1 to the lowpass cutoff: 700 Hz to 21 kHz on an exponential
+// scale, close to the old one-pole's range at 44.1 kHz
+static float toneToCutoffHz(float tone)
+{
+    return 700.0f * std::pow(30.0f, tone);
+}
+
+// A control plus matrix modulation (-1 to 1) scaled by range, clamped to
+// 0-maxValue. Unmodulated controls are passed through as they are.
+static DelayWaveDSP::ControlSignal modulate(const DelayWaveDSP::ControlSignal& control, const DelayWaveDSP::ControlSignal& modulation,
+                                            float range, float maxValue, float* buffer, int numSamples)
+{
+    if (modulation.isConstant())
+        return control;
+
+    for (int i = 0; i < numSamples; ++i)
+        buffer[i] = juce::jlimit(0.0f, maxValue, control[i] + range * modulation[i]);
+
+    return DelayWaveDSP::ControlSignal::perSample(buffer);
+}
+
+template <typename SampleType>
+static std::unique_ptr<juce::dsp::Oversampling<SampleType>> createOversampler(int numChannels, int factorIndex,
+                                                                             int filter, int blockSize)
+{
+    using Oversampling = juce::dsp::Oversampling<SampleType>;
+
+    // Polyphase IIR (low latency) or equiripple FIR (linear phase)
+    const auto filterType = filter == 0 ? Oversampling::filterHalfBandPolyphaseIIR
+                                        : Oversampling::filterHalfBandFIREquiripple;
+
+    auto oversampling = std::make_unique<Oversampling>(static_cast<size_t>(numChannels),
+                                                       static_cast<size_t>(factorIndex), filterType, true, true);
+    oversampling->initProcessing(static_cast<size_t>(blockSize));
+    return oversampling;
+}
+
+template <typename SampleType>
+DelayWaveDSP::DelayProcessor<SampleType>& DelayWaveProcessor::getDelayEngine()
+{
+    if constexpr (std::is_same_v<SampleType, double>)
+        return *delayEngineDouble;
+    else
+        return *delayEngine;
+}
+
+template <typename SampleType>
+std::unique_ptr<juce::dsp::Oversampling<SampleType>>& DelayWaveProcessor::getOversampler()
+{
+    if constexpr (std::is_same_v<SampleType, double>)
+        return oversamplerDouble;
+    else
+        return oversampler;
+}
+
+template <typename SampleType>
+juce::AudioBuffer<SampleType>& DelayWaveProcessor::getBypassDryBuffer()
+{
+    if constexpr (std::is_same_v<SampleType, double>)
+        return bypassDryBufferDouble;
+    else
+        return bypassDryBuffer;
+}
+
+//==============================================================================
+void DelayWaveProcessor::prepareToPlay(double hostSampleRate, int samplesPerBlock)
 {
+    hostBlockSize = juce::jmax(1, samplesPerBlock);
+
+    // Oversampling: the whole delay core runs at the raised rate
+    activeOversampling = static_cast<int>(apvts.getRawParameterValue(ParamIDs::oversampling)->load());
+    activeOversamplingFilter = static_cast<int>(apvts.getRawParameterValue(ParamIDs::oversamplingFilter)->load());
+
+    // Only the engine and oversampler for the host's precision hold memory
+    const bool useDouble = isUsingDoublePrecision();
+    const int numInputChannels = juce::jmax(1, getTotalNumInputChannels());
+
+    oversampler.reset();
+    oversamplerDouble.reset();
+
+    if (activeOversampling > 0)
+    {
+        if (useDouble)
+            oversamplerDouble = createOversampler<double>(numInputChannels, activeOversampling, activeOversamplingFilter, hostBlockSize);
+        else
+            oversampler = createOversampler<float>(numInputChannels, activeOversampling, activeOversamplingFilter, hostBlockSize);
+
+        setLatencySamples(juce::roundToInt(useDouble ? oversamplerDouble->getLatencyInSamples()
+                                                     : oversampler->getLatencyInSamples()));
+    }
+    else
+    {
+        setLatencySamples(0);
+    }
+
+    const int oversamplingFactor = 1 << activeOversampling;
+    const double sampleRate = hostSampleRate * oversamplingFactor;
     currentSampleRate = sampleRate;
 
-    // Prepare delay lines with 2x headroom for variable buffer sizes
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock * 2);
-    spec.numChannels = 2;
+    // Delay engine: one interleaved ring buffer per group of four channels of
+    // the bus layout, sized for the longest reachable read position at this
+    // sample rate: the end of the Time range or the longest synced time, and
+    // the LFO wobble on top. Time modulation gets no extra room: stretched
+    // read positions past the end are held there by the engine.
+    // Nothing is allocated before the first prepareToPlay, and preparing
+    // again for the same or a lower rate reuses the existing memory. This is
+    // also where each group picks its mono, stereo or multichannel kernels.
+    const double maxReadSeconds = getLongestDelayTimeMs() / 1000.0 + maxModulationSeconds;
+    int maxDelaySamples = static_cast<int>(std::ceil(maxReadSeconds * sampleRate)) + 1;
+
+    if (useDouble)
+    {
+        delayEngineDouble->prepare(maxDelaySamples, numInputChannels, sampleRate);
+        delayEngine->release();
+    }
+    else
+    {
+        delayEngine->prepare(maxDelaySamples, numInputChannels, sampleRate);
+        delayEngineDouble->release();
+    }
+
+    // Centre and LFE keep their own feedback in ping-pong and diffuse
+    // modes; a mono bus is also "centre", but is its own image
+    const auto channelSet = getChannelLayoutOfBus(true, 0);
+    numFeedbackGroups = (numInputChannels + DelayWaveDSP::FeedbackMatrix::size - 1) / DelayWaveDSP::FeedbackMatrix::size;
+    fixedFeedbackLanes.fill(0);
+
+    const int numLayoutChannels = channelSet.size() > 1 ? juce::jmin(channelSet.size(), DelayWaveDSP::DelayProcessor<>::maxChannels) : 0;
+
+    for (int ch = 0; ch < numLayoutChannels; ++ch)
+    {
+        const auto type = channelSet.getTypeOfChannel(ch);
 
-    delayLineL.prepare(spec);
-    delayLineR.prepare(spec);
+        if (type == juce::AudioChannelSet::centre || type == juce::AudioChannelSet::LFE || type == juce::AudioChannelSet::LFE2)
+            fixedFeedbackLanes[static_cast<size_t>(ch / DelayWaveDSP::FeedbackMatrix::size)] |= 1u << (ch % DelayWaveDSP::FeedbackMatrix::size);
+    }
 
-    // Set max delay
-    int maxDelaySamples = static_cast<int>(maxDelaySeconds * sampleRate);
-    delayLineL.setMaximumDelayInSamples(maxDelaySamples);
-    delayLineR.setMaximumDelayInSamples(maxDelaySamples);
+    // Mono and stereo groups only store one or two lanes, and the spare
+    // lanes past those read back as silence; mixing into them would drop
+    // energy, so they keep out of the matrix as well
+    for (int group = 0; group < numFeedbackGroups; ++group)
+    {
+        const int groupChannels = juce::jmin(numInputChannels - group * DelayWaveDSP::FeedbackMatrix::size,
+                                             DelayWaveDSP::FeedbackMatrix::size);
+
+        for (int lane = DelayWaveDSP::getRingLanes(groupChannels); lane < DelayWaveDSP::FeedbackMatrix::size; ++lane)
+            fixedFeedbackLanes[static_cast<size_t>(group)] |= 1u << lane;
+    }
 
-    // Initialize smoothed values (20ms smoothing time)
-    smoothedTime.reset(sampleRate, 0.02);
-    smoothedFeedback.reset(sampleRate, 0.02);
-    smoothedMix.reset(sampleRate, 0.02);
-    smoothedModRate.reset(sampleRate, 0.02);
-    smoothedModDepth.reset(sampleRate, 0.02);
-    smoothedTone.reset(sampleRate, 0.02);
+    // Control buffers; larger host blocks are processed in chunks of this size
+    maxControlBlockSize = hostBlockSize * oversamplingFactor;
+    for (auto* controlBuffer : { &baseDelayBuffer, &sideDelayBuffer, &modAmountBuffer, &bypassGainBuffer, &bypassMixBuffer,
+                                 &modFeedbackBuffer, &modSideFeedbackBuffer, &modMixBuffer, &jumpFadeBuffer })
+        controlBuffer->assign(static_cast<size_t>(maxControlBlockSize), 0.0f);
+
+    // One read position buffer per channel of the bus layout, and one for
+    // the second read head in jump mode
+    const int numDelayChannels = useDouble ? delayEngineDouble->getNumChannels() : delayEngine->getNumChannels();
+    delayBuffers.assign(static_cast<size_t>(maxControlBlockSize * numDelayChannels), 0.0f);
+    jumpDelayBuffers.assign(static_cast<size_t>(maxControlBlockSize * numDelayChannels), 0.0f);
+    readHeads.prepare(sampleRate);
+    tapLayoutTone = -1.0f;  // The tap filters depend on the rate
+
+    // Bypass starts settled in the current state; the dry copy for ring out
+    // exists for the host's precision only
+    bypassFader.prepare(sampleRate, apvts.getRawParameterValue(ParamIDs::bypass)->load() > 0.5f);
+    delayFlushed = true;
+    bypassDryBuffer.setSize(useDouble ? 0 : numDelayChannels, useDouble ? 0 : maxControlBlockSize);
+    bypassDryBufferDouble.setSize(useDouble ? numDelayChannels : 0, useDouble ? maxControlBlockSize : 0);
+
+    // Initialize smoothed values (20ms smoothing time). The LFO rate only
+    // needs control-rate updates.
+    smoothers.prepare(sampleRate, maxControlBlockSize, numSmoothedParams, 0.02);
+    smoothers.setControlInterval(smoothModRate, 32);
+    smoothers.setControlInterval(smoothTone, 32);
 
     // Set initial values
-    smoothedTime.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::time)->load());
-    smoothedFeedback.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::feedback)->load());
-    smoothedMix.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::mix)->load());
-    smoothedModRate.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::modRate)->load());
-    smoothedModDepth.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::modDepth)->load());
-    smoothedTone.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::tone)->load());
+    updateSmoothedTargets(true);
 
-    // Reset filter state
-    filterStateL = 0.0f;
-    filterStateR = 0.0f;
+    // Reset LFO phase; it is re-locked to the host on the next playing block
+    lfo.prepare(sampleRate);
+    modulation.prepare(sampleRate, maxControlBlockSize, modControlInterval * oversamplingFactor);
+    transport.reset();
 
-    // Reset LFO phase
-    lfoPhase = 0.0f;
+    // Sleep once the input is silent and nothing audible has been written
+    // for the whole ring length (counted in host samples)
+    silenceDetector.prepare(maxDelaySamples / oversamplingFactor + 1);
+    sleeping.store(false);
+    activeDutyCycle.store(1.0f);
+
+    // Block deadlines are in host samples
+    cpuLoadMeter.prepare(hostSampleRate);
+
+    size_t controlBytes = 0;
+    for (const auto* controlBuffer : { &baseDelayBuffer, &sideDelayBuffer, &modAmountBuffer, &delayBuffers,
+                                       &bypassGainBuffer, &bypassMixBuffer, &modFeedbackBuffer, &modSideFeedbackBuffer,
+                                       &modMixBuffer, &jumpFadeBuffer, &jumpDelayBuffers })
+        controlBytes += controlBuffer->capacity() * sizeof(float);
+
+    controlBytes += static_cast<size_t>(bypassDryBuffer.getNumChannels() * bypassDryBuffer.getNumSamples()) * sizeof(float)
+                  + static_cast<size_t>(bypassDryBufferDouble.getNumChannels() * bypassDryBufferDouble.getNumSamples()) * sizeof(double);
+
+    dspMemoryBytes.store(delayEngine->getMemoryUsageBytes() + delayEngineDouble->getMemoryUsageBytes()
+                         + smoothers.getMemoryUsageBytes() + modulation.getMemoryUsageBytes() + controlBytes);
 }
 
 void DelayWaveProcessor::releaseResources()
 {
-    delayLineL.reset();
-    delayLineR.reset();
+    delayEngine->reset();
+    delayEngineDouble->reset();
+
+    if (oversampler != nullptr)
+        oversampler->reset();
+
+    if (oversamplerDouble != nullptr)
+        oversamplerDouble->reset();
 }
 
 bool DelayWaveProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any layout up to 16 channels (mono, stereo, 5.1, 7.1, 7.1.4, ...)
+    const auto& output = layouts.getMainOutputChannelSet();
+    if (output.isDisabled() || output.size() > DelayWaveDSP::DelayProcessor<>::maxChannels)
         return false;
 
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
@@ -197,6 +688,24 @@ bool DelayWaveProcessor::isBusesLayoutSupported(const BusesLayout& layouts) cons
 void DelayWaveProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ignoreUnused(midiMessages);
+
+    const auto blockStart = cpuLoadMeter.begin();
+    processSamples(buffer);
+    cpuLoadMeter.end(blockStart, buffer.getNumSamples());
+}
+
+void DelayWaveProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ignoreUnused(midiMessages);
+
+    const auto blockStart = cpuLoadMeter.begin();
+    processSamples(buffer);
+    cpuLoadMeter.end(blockStart, buffer.getNumSamples());
+}
+
+template <typename SampleType>
+void DelayWaveProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
+{
     juce::ScopedNoDenormals noDenormals;
 
     auto totalNumInputChannels = getTotalNumInputChannels();
@@ -208,23 +717,36 @@ void DelayWaveProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
         buffer.clear(i, 0, numSamples);
 
     // Measure input levels before processing
-    float inL = buffer.getMagnitude(0, 0, numSamples);
-    float inR = totalNumInputChannels > 1 ? buffer.getMagnitude(1, 0, numSamples) : inL;
+    float inL = static_cast<float>(buffer.getMagnitude(0, 0, numSamples));
+    float inR = totalNumInputChannels > 1 ? static_cast<float>(buffer.getMagnitude(1, 0, numSamples)) : inL;
     inputLevelL.store(inL);
     inputLevelR.store(inR);
 
-    // Get parameter values
-    bool bypassValue = apvts.getRawParameterValue(ParamIDs::bypass)->load() > 0.5f;
+    float inputPeak = juce::jmax(inL, inR);
+    for (int ch = 2; ch < totalNumInputChannels; ++ch)
+        inputPeak = juce::jmax(inputPeak, static_cast<float>(buffer.getMagnitude(ch, 0, numSamples)));
 
-    if (bypassValue)
+    // Host tempo and position, read once per block
+    updateHostPosition(numSamples);
+
+    // Bypass crossfades over a few ms (see processDelay). With the Stop
+    // tail, the delay is flushed once the fade is over and then costs
+    // nothing until bypass is switched off again; with Ring Out it keeps
+    // running on a silent input until its tail has died away.
+    bypassFader.setBypassed(apvts.getRawParameterValue(ParamIDs::bypass)->load() > 0.5f);
+    const bool ringOut = static_cast<int>(apvts.getRawParameterValue(ParamIDs::bypassTail)->load()) == 1;
+
+    if (bypassFader.isBypassed() && ! ringOut)
     {
-        // Reset smoothed values to prevent clicks when re-enabling
-        smoothedTime.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::time)->load());
-        smoothedFeedback.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::feedback)->load());
-        smoothedMix.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::mix)->load());
-        smoothedModRate.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::modRate)->load());
-        smoothedModDepth.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::modDepth)->load());
-        smoothedTone.setCurrentAndTargetValue(apvts.getRawParameterValue(ParamIDs::tone)->load());
+        if (! delayFlushed)
+        {
+            getDelayEngine<SampleType>().reset();
+            delayFlushed = true;
+        }
+
+        // Re-enable on the current settings rather than gliding from old ones
+        updateSmoothedTargets(true);
+        processBypassed(buffer, totalNumInputChannels);
 
         // Measure output levels even when bypassed
         outputLevelL.store(inL);
@@ -232,91 +754,548 @@ void DelayWaveProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
         return;
     }
 
+    // Asleep: the input is silent and so is everything left in the delay,
+    // so the (silent) dry signal is passed through untouched. The first
+    // block with input above -120 dBFS wakes the engine again. A ringing
+    // out tail gets no input, so it sleeps as soon as it has died away.
+    const bool asleep = silenceDetector.beginBlock(bypassFader.isBypassed() ? 0.0f : inputPeak, numSamples);
+    sleeping.store(asleep);
+    activeDutyCycle.store(silenceDetector.getActiveRatio());
+
+    if (asleep)
+    {
+        // Wake up on the current settings rather than gliding from old ones
+        updateSmoothedTargets(true);
+
+        if (bypassFader.isBypassed())
+            processBypassed(buffer, totalNumInputChannels);
+
+        outputLevelL.store(inL);
+        outputLevelR.store(inR);
+        return;
+    }
+
     // Update target values
-    smoothedTime.setTargetValue(apvts.getRawParameterValue(ParamIDs::time)->load());
-    smoothedFeedback.setTargetValue(apvts.getRawParameterValue(ParamIDs::feedback)->load());
-    smoothedMix.setTargetValue(apvts.getRawParameterValue(ParamIDs::mix)->load());
-    smoothedModRate.setTargetValue(apvts.getRawParameterValue(ParamIDs::modRate)->load());
-    smoothedModDepth.setTargetValue(apvts.getRawParameterValue(ParamIDs::modDepth)->load());
-    smoothedTone.setTargetValue(apvts.getRawParameterValue(ParamIDs::tone)->load());
+    updateSmoothedTargets(false);
+    blockWritePeak = 0.0f;
+    delayFlushed = false;
 
-    // Get channel pointers
-    auto* leftChannel = buffer.getWritePointer(0);
-    auto* rightChannel = totalNumInputChannels > 1 ? buffer.getWritePointer(1) : leftChannel;
+    auto& engine = getDelayEngine<SampleType>();
+    auto& activeOversampler = getOversampler<SampleType>();
+    const int numChannels = juce::jmin(totalNumInputChannels, engine.getNumChannels());
 
-    // LFO phase increment base (will be modulated per sample)
-    const float twoPi = juce::MathConstants<float>::twoPi;
+    if (activeOversampler != nullptr)
+    {
+        // Hosts may send more than the prepared block size, so run the
+        // oversampler in blocks it was initialised for
+        juce::dsp::AudioBlock<SampleType> block(buffer.getArrayOfWritePointers(),
+                                                static_cast<size_t>(numChannels),
+                                                static_cast<size_t>(numSamples));
+
+        for (int start = 0; start < numSamples; start += hostBlockSize)
+        {
+            auto subBlock = block.getSubBlock(static_cast<size_t>(start),
+                                              static_cast<size_t>(juce::jmin(hostBlockSize, numSamples - start)));
+            auto upsampled = activeOversampler->processSamplesUp(subBlock);
 
-    for (int sample = 0; sample < numSamples; ++sample)
+            SampleType* channels[DelayWaveDSP::DelayProcessor<>::maxChannels] {};
+            for (int ch = 0; ch < numChannels; ++ch)
+                channels[ch] = upsampled.getChannelPointer(static_cast<size_t>(ch));
+
+            processDelay(channels, numChannels, static_cast<int>(upsampled.getNumSamples()));
+            activeOversampler->processSamplesDown(subBlock);
+        }
+    }
+    else
     {
-        // Get smoothed parameter values
-        float timeMs = smoothedTime.getNextValue();
-        float feedback = smoothedFeedback.getNextValue();
-        float mix = smoothedMix.getNextValue();
-        float modRate = smoothedModRate.getNextValue();
-        float modDepth = smoothedModDepth.getNextValue();
-        float tone = smoothedTone.getNextValue();
-
-        // Convert time to samples
-        float baseDelaySamples = (timeMs / 1000.0f) * static_cast<float>(currentSampleRate);
-
-        // Calculate LFO modulation (sine wave)
-        float lfoValue = std::sin(lfoPhase);
-
-        // Modulation amount (up to 20ms of wobble)
-        float modAmount = modDepth * 0.02f * static_cast<float>(currentSampleRate);
-        float modulatedDelaySamplesL = baseDelaySamples + lfoValue * modAmount;
-        float modulatedDelaySamplesR = baseDelaySamples - lfoValue * modAmount;  // Inverted for stereo width
-
-        // Clamp to valid range
-        modulatedDelaySamplesL = juce::jlimit(1.0f, static_cast<float>(delayLineL.getMaximumDelayInSamples() - 1), modulatedDelaySamplesL);
-        modulatedDelaySamplesR = juce::jlimit(1.0f, static_cast<float>(delayLineR.getMaximumDelayInSamples() - 1), modulatedDelaySamplesR);
-
-        // Read from delay lines
-        float delayedL = delayLineL.popSample(0, modulatedDelaySamplesL);
-        float delayedR = delayLineR.popSample(0, modulatedDelaySamplesR);
-
-        // Apply tone filter (simple one-pole lowpass)
-        // tone = 0 -> very dark (low cutoff), tone = 1 -> bright (high cutoff)
-        float filterCoeff = 0.1f + tone * 0.85f;  // Range from 0.1 to 0.95
-        filterStateL = filterStateL + filterCoeff * (delayedL - filterStateL);
-        filterStateR = filterStateR + filterCoeff * (delayedR - filterStateR);
-
-        float filteredL = filterStateL;
-        float filteredR = filterStateR;
-
-        // Get dry input
-        float dryL = leftChannel[sample];
-        float dryR = rightChannel[sample];
-
-        // Write to delay lines (input + filtered feedback)
-        delayLineL.pushSample(0, dryL + filteredL * feedback);
-        delayLineR.pushSample(0, dryR + filteredR * feedback);
-
-        // Mix dry and wet
-        leftChannel[sample] = dryL * (1.0f - mix) + filteredL * mix;
-        rightChannel[sample] = dryR * (1.0f - mix) + filteredR * mix;
-
-        // Advance LFO phase
-        lfoPhase += twoPi * modRate / static_cast<float>(currentSampleRate);
-        if (lfoPhase >= twoPi)
-            lfoPhase -= twoPi;
+        processDelay(buffer.getArrayOfWritePointers(), numChannels, numSamples);
     }
 
+    silenceDetector.endBlock(blockWritePeak, numSamples);
+
     // Measure output levels after processing
-    float outL = buffer.getMagnitude(0, 0, numSamples);
-    float outR = totalNumInputChannels > 1 ? buffer.getMagnitude(1, 0, numSamples) : outL;
+    float outL = static_cast<float>(buffer.getMagnitude(0, 0, numSamples));
+    float outR = totalNumInputChannels > 1 ? static_cast<float>(buffer.getMagnitude(1, 0, numSamples)) : outL;
     outputLevelL.store(outL);
     outputLevelR.store(outR);
 }
 
+template <typename SampleType>
+void DelayWaveProcessor::processBypassed(juce::AudioBuffer<SampleType>& buffer, int numChannels)
+{
+    // The dry signal still goes through the oversampling filters, so the
+    // latency (and phase) stay the same as when processing and switching
+    // bypass never jumps in time
+    auto& activeOversampler = getOversampler<SampleType>();
+    if (activeOversampler == nullptr)
+        return;
+
+    const int numSamples = buffer.getNumSamples();
+    juce::dsp::AudioBlock<SampleType> block(buffer.getArrayOfWritePointers(),
+                                            static_cast<size_t>(juce::jmin(numChannels, getDelayEngine<SampleType>().getNumChannels())),
+                                            static_cast<size_t>(numSamples));
+
+    for (int start = 0; start < numSamples; start += hostBlockSize)
+    {
+        auto subBlock = block.getSubBlock(static_cast<size_t>(start),
+                                          static_cast<size_t>(juce::jmin(hostBlockSize, numSamples - start)));
+        activeOversampler->processSamplesUp(subBlock);
+        activeOversampler->processSamplesDown(subBlock);
+    }
+}
+
+template <typename SampleType>
+void DelayWaveProcessor::processDelay(SampleType* const* channels, int numChannels, int numSamples)
+{
+    const auto mode = kernelMode.load();
+    const auto sampleRate = static_cast<float>(currentSampleRate);
+
+    // LFO shape and phase spread, applied once per block. The spread runs
+    // from 0 on the first channel to the full Mod Phase on the last, so in
+    // stereo the right channel is offset by Mod Phase.
+    lfo.setShape(static_cast<DelayWaveDSP::LfoShape>(
+        static_cast<int>(apvts.getRawParameterValue(ParamIDs::modShape)->load())));
+
+    const double phaseSpread = apvts.getRawParameterValue(ParamIDs::modPhase)->load() / 360.0;
+    for (int ch = 0; ch < numChannels; ++ch)
+        lfo.setPhaseOffset(ch, numChannels > 1 ? phaseSpread * ch / (numChannels - 1) : 0.0);
+
+    // Mid/side only changes how a stereo engine runs its two lanes; the
+    // kernel for the bus layout was picked in prepareToPlay
+    auto& engine = getDelayEngine<SampleType>();
+    const bool midSide = numChannels == 2 && apvts.getRawParameterValue(ParamIDs::midSide)->load() > 0.5f;
+    engine.setMidSide(midSide);
+
+    updateTapLayout();
+    updateFeedbackMatrix(midSide);
+
+    // LFO output per channel, turned into read positions in place, and the
+    // second read head's positions in jump mode
+    float* lfoOutputs[DelayWaveDSP::DelayProcessor<>::maxChannels] {};
+    float* jumpOutputs[DelayWaveDSP::DelayProcessor<>::maxChannels] {};
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        lfoOutputs[ch] = delayBuffers.data() + ch * maxControlBlockSize;
+        jumpOutputs[ch] = jumpDelayBuffers.data() + ch * maxControlBlockSize;
+    }
+
+    // Tape mode slides the read position through the smoothed time; jump
+    // mode holds whole-sample heads and crossfades to the target time.
+    // Switching mode picks up from where the other one's head is.
+    const float msToSamples = sampleRate / 1000.0f;
+    const float sideTimeMs = apvts.getRawParameterValue(ParamIDs::sideTime)->load();
+    const bool jump = static_cast<int>(apvts.getRawParameterValue(ParamIDs::timeMode)->load()) == 1;
+    const float jumpTargets[] = { getTargetDelayTimeMs() * msToSamples, sideTimeMs * msToSamples };
+
+    if (jump && ! jumpMode)
+    {
+        const float heads[] = { smoothers.getCurrentValue(smoothTime) * msToSamples,
+                                smoothers.getCurrentValue(smoothSideTime) * msToSamples };
+        readHeads.snapTo(heads, 2);
+    }
+    else if (! jump && jumpMode)
+    {
+        smoothers.setCurrentAndTargetValue(smoothTime, readHeads.getCurrent(0) / msToSamples);
+        smoothers.setCurrentAndTargetValue(smoothSideTime, readHeads.getCurrent(1) / msToSamples);
+        smoothers.setTargetValue(smoothTime, getTargetDelayTimeMs());
+        smoothers.setTargetValue(smoothSideTime, sideTimeMs);
+    }
+
+    jumpMode = jump;
+
+    DelayWaveDSP::DelayBlockParams params;
+    const int toneSlope = static_cast<int>(apvts.getRawParameterValue(ParamIDs::toneSlope)->load()) + 1;
+    const float lowCutHz = apvts.getRawParameterValue(ParamIDs::lowCut)->load();
+
+    params.saturation.curve = static_cast<DelayWaveDSP::SaturationCurve>(
+        static_cast<int>(apvts.getRawParameterValue(ParamIDs::saturationMode)->load()));
+    params.saturation.drive = juce::Decibels::decibelsToGain(apvts.getRawParameterValue(ParamIDs::saturation)->load());
+
+    // The engine glides the diffuser to these over each chunk
+    params.diffusion.amount = apvts.getRawParameterValue(ParamIDs::diffusion)->load();
+    params.diffusion.stages = static_cast<int>(apvts.getRawParameterValue(ParamIDs::diffusionStages)->load());
+
+    const bool ringOut = static_cast<int>(apvts.getRawParameterValue(ParamIDs::bypassTail)->load()) == 1;
+    auto& bypassDry = getBypassDryBuffer<SampleType>();
+
+    // The tone filter only takes a new setting per chunk, so modulating it
+    // needs shorter chunks
+    updateModulationMatrix();
+    const float maxFeedback = apvts.getParameterRange(ParamIDs::feedback).end;
+    const int chunkSize = modulation.isRouted(DelayWaveDSP::ModDestination::Tone)
+                              ? juce::jmin(maxControlBlockSize, 4 * modulation.getControlInterval())
+                              : maxControlBlockSize;
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const int blockSize = juce::jmin(chunkSize, numSamples - start);
+
+        SampleType* chunk[DelayWaveDSP::DelayProcessor<>::maxChannels] {};
+        for (int ch = 0; ch < numChannels; ++ch)
+            chunk[ch] = channels[ch] + start;
+
+        // Advance the smoothers; only parameters that are moving get a ramp
+        smoothers.process(blockSize);
+
+        const auto time = smoothers.get(smoothTime);
+        const auto sideTime = smoothers.get(smoothSideTime);
+        const auto modDepth = smoothers.get(smoothModDepth);
+
+        // Render the LFO for the whole chunk, then the matrix (which reads
+        // the LFO and the input)
+        lfo.process(smoothers.get(smoothModRate), blockSize, lfoOutputs, numChannels);
+        modulation.process(lfoOutputs[0], chunk, numChannels, blockSize);
+
+        const auto timeMod = modulation.get(DelayWaveDSP::ModDestination::Time);
+        const auto toneMod = modulation.get(DelayWaveDSP::ModDestination::Tone);
+        const auto panMod = modulation.get(DelayWaveDSP::ModDestination::Pan);
+
+        params.feedback = modulate(smoothers.get(smoothFeedback), modulation.get(DelayWaveDSP::ModDestination::Feedback),
+                                   modFeedbackRange, maxFeedback, modFeedbackBuffer.data(), blockSize);
+        params.sideFeedback = modulate(smoothers.get(smoothSideFeedback), modulation.get(DelayWaveDSP::ModDestination::Feedback),
+                                       modFeedbackRange, maxFeedback, modSideFeedbackBuffer.data(), blockSize);
+        params.mix = modulate(smoothers.get(smoothMix), modulation.get(DelayWaveDSP::ModDestination::Mix),
+                              modMixRange, 1.0f, modMixBuffer.data(), blockSize);
+
+        // Tone filter, set in Hz once per chunk; the engine glides the
+        // coefficients across it
+        const float tone = juce::jlimit(0.0f, 1.0f, smoothers.getCurrentValue(smoothTone) + modToneRange * toneMod.value);
+        params.tone.lowpassHz = toneToCutoffHz(tone);
+        params.tone.highpassHz = lowCutHz > lowCutOffHz ? lowCutHz : 0.0f;
+        params.tone.slope = toneSlope;
+
+        // Turn the LFO into read positions: time in samples plus up to 20ms
+        // of wobble (the engine clamps them to the valid range)
+        const float depthToSamples = maxModulationSeconds * sampleRate;
+
+        const bool timeRamps = ! time.isConstant() || ! timeMod.isConstant();
+        const bool sideTimeRamps = ! sideTime.isConstant() || ! timeMod.isConstant();
+
+        const auto jumpFade = jump ? readHeads.process(jumpTargets, midSide ? 2 : 1, jumpFadeBuffer.data(), blockSize)
+                                   : DelayWaveDSP::ControlSignal::constant(0.0f);
+        const bool jumping = jump && readHeads.isFading();
+
+        // Jump mode places its heads per channel below
+        if (! jump && ! timeMod.isConstant())
+        {
+            // Time modulation scales the time, so both mid/side lanes move alike;
+        // the engine holds positions past the end of the ring there
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const float scale = msToSamples * (1.0f + modTimeRange * timeMod[i]);
+                baseDelayBuffer[static_cast<size_t>(i)] = time[i] * scale;
+
+                if (midSide)
+                    sideDelayBuffer[static_cast<size_t>(i)] = sideTime[i] * scale;
+            }
+        }
+        else if (! jump)
+        {
+            if (! time.isConstant())
+                juce::FloatVectorOperations::multiply(baseDelayBuffer.data(), time.ramp, msToSamples, blockSize);
+
+            if (midSide && ! sideTime.isConstant())
+                juce::FloatVectorOperations::multiply(sideDelayBuffer.data(), sideTime.ramp, msToSamples, blockSize);
+        }
+
+        if (! modDepth.isConstant())
+            juce::FloatVectorOperations::multiply(modAmountBuffer.data(), modDepth.ramp, depthToSamples, blockSize);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (modDepth.isConstant())
+                juce::FloatVectorOperations::multiply(lfoOutputs[ch], modDepth.value * depthToSamples, blockSize);
+            else
+                juce::FloatVectorOperations::multiply(lfoOutputs[ch], modAmountBuffer.data(), blockSize);
+
+            // Channel 1 is the side in mid/side
+            const bool side = midSide && ch == 1;
+            const auto& channelTime = side ? sideTime : time;
+
+            if (jump)
+            {
+                // Time modulation scales both heads alike
+                const float current = readHeads.getCurrent(side ? 1 : 0);
+                const float next = readHeads.getNext(side ? 1 : 0);
+
+                if (jumping)
+                    juce::FloatVectorOperations::copy(jumpOutputs[ch], lfoOutputs[ch], blockSize);
+
+                if (timeMod.isConstant())
+                {
+                    juce::FloatVectorOperations::add(lfoOutputs[ch], current, blockSize);
+
+                    if (jumping)
+                        juce::FloatVectorOperations::add(jumpOutputs[ch], next, blockSize);
+                }
+                else
+                {
+                    for (int i = 0; i < blockSize; ++i)
+                    {
+                        const float scale = 1.0f + modTimeRange * timeMod[i];
+                        lfoOutputs[ch][i] += current * scale;
+
+                        if (jumping)
+                            jumpOutputs[ch][i] += next * scale;
+                    }
+                }
+            }
+            else if (! (side ? sideTimeRamps : timeRamps))
+                juce::FloatVectorOperations::add(lfoOutputs[ch], channelTime.value * msToSamples, blockSize);
+            else
+                juce::FloatVectorOperations::add(lfoOutputs[ch], side ? sideDelayBuffer.data() : baseDelayBuffer.data(), blockSize);
+        }
+
+        // Bypass: 1 = processed, 0 = dry. Stop fades the wet signal out
+        // through the mix; Ring Out fades out what is fed into the delay
+        // and adds the rest of the dry signal back afterwards, so the tail
+        // carries on over the dry signal.
+        const auto bypassGain = bypassFader.process(bypassGainBuffer.data(), blockSize);
+        const bool bypassing = ! bypassGain.isConstant() || bypassGain.value < 1.0f;
+
+        if (bypassing && ! ringOut)
+        {
+            if (params.mix.isConstant() && bypassGain.isConstant())
+            {
+                params.mix = DelayWaveDSP::ControlSignal::constant(params.mix.value * bypassGain.value);
+            }
+            else
+            {
+                for (int i = 0; i < blockSize; ++i)
+                    bypassMixBuffer[static_cast<size_t>(i)] = params.mix[i] * bypassGain[i];
+
+                params.mix = DelayWaveDSP::ControlSignal::perSample(bypassMixBuffer.data());
+            }
+        }
+        else if (bypassing)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto* dry = bypassDry.getWritePointer(ch);
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    const auto gain = static_cast<SampleType>(bypassGain[i]);
+                    dry[i] = chunk[ch][i] * (SampleType(1) - gain);
+                    chunk[ch][i] *= gain;
+                }
+            }
+        }
+
+        // Unmodulated jump heads sit on whole samples, so the reads need no
+        // interpolation
+        params.jumpFade = jumpFade;
+        params.wholeSampleDelays = jump && modDepth.isConstant() && juce::exactlyEqual(modDepth.value, 0.0f) && timeMod.isConstant();
+
+        // Delay read, interpolation, tone filter, feedback write and mix
+        engine.process(chunk, numChannels, blockSize, params, lfoOutputs, jumping ? jumpOutputs : nullptr, mode);
+        blockWritePeak = juce::jmax(blockWritePeak, static_cast<float>(engine.getWritePeak()));
+
+        // Pan: a balance between even (left) and odd (right) channels,
+        // faded out with the bypass so it never steps
+        if (! panMod.isConstant() && numChannels > 1)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float direction = (ch & 1) == 0 ? -1.0f : 1.0f;
+
+                for (int i = 0; i < blockSize; ++i)
+                    chunk[ch][i] *= static_cast<SampleType>(juce::jmin(1.0f, 1.0f + direction * panMod[i] * bypassGain[i]));
+            }
+        }
+
+        if (bypassing && ringOut)
+            for (int ch = 0; ch < numChannels; ++ch)
+                juce::FloatVectorOperations::add(chunk[ch], bypassDry.getReadPointer(ch), blockSize);
+    }
+}
+
+void DelayWaveProcessor::updateModulationMatrix()
+{
+    static_assert(ParamIDs::numModSlots == DelayWaveDSP::ModulationMatrix::maxRoutings);
+
+    for (int slot = 0; slot < ParamIDs::numModSlots; ++slot)
+    {
+        DelayWaveDSP::ModRouting routing;
+        routing.source = static_cast<DelayWaveDSP::ModSource>(
+            static_cast<int>(apvts.getRawParameterValue(ParamIDs::modSource[slot])->load()));
+        routing.destination = static_cast<DelayWaveDSP::ModDestination>(
+            static_cast<int>(apvts.getRawParameterValue(ParamIDs::modDestination[slot])->load()));
+        routing.amount = apvts.getRawParameterValue(ParamIDs::modAmount[slot])->load();
+        modulation.setRouting(slot, routing);
+    }
+
+    modulation.setLfo2(apvts.getRawParameterValue(ParamIDs::lfo2Rate)->load(),
+                       static_cast<DelayWaveDSP::LfoShape>(static_cast<int>(apvts.getRawParameterValue(ParamIDs::lfo2Shape)->load())));
+    modulation.setRandomRate(apvts.getRawParameterValue(ParamIDs::randomRate)->load());
+    modulation.setEnvelope(apvts.getRawParameterValue(ParamIDs::envAttack)->load(),
+                           apvts.getRawParameterValue(ParamIDs::envRelease)->load());
+}
+
+void DelayWaveProcessor::updateTapLayout()
+{
+    // The main read head is the last tap; the extra ones sit at even
+    // fractions of its time, fading and darkening towards the main head
+    // and alternating sides
+    const int numTaps = static_cast<int>(apvts.getRawParameterValue(ParamIDs::taps)->load());
+    const float decay = apvts.getRawParameterValue(ParamIDs::tapDecay)->load();
+    const float spread = apvts.getRawParameterValue(ParamIDs::tapSpread)->load();
+    tapLayout.numTaps = juce::jlimit(0, DelayWaveDSP::TapLayout::maxTaps, numTaps - 1);
+
+    for (int t = 0; t < tapLayout.numTaps; ++t)
+    {
+        tapLayout.time[t] = static_cast<float>(t + 1) / static_cast<float>(numTaps);
+        tapLayout.gain[t] = std::pow(1.0f - decay, static_cast<float>(t));
+        tapLayout.pan[t] = (t & 1) == 0 ? -spread : spread;
+    }
+
+    // The filters follow the smoothed Tone, like the main path, and are only
+    // worked out again when it moves. One-pole coefficients from Hz, so the
+    // taps also match across rates.
+    const float tone = smoothers.getCurrentValue(smoothTone);
+
+    if (! juce::exactlyEqual(tone, tapLayoutTone))
+    {
+        const float toneHz = toneToCutoffHz(tone);
+
+        for (int t = 0; t < DelayWaveDSP::TapLayout::maxTaps; ++t)
+        {
+            const double cutoff = toneHz * std::pow(0.7, t);
+            tapLayout.filterCoeff[t] = static_cast<float>(1.0 - std::exp(-juce::MathConstants<double>::twoPi * cutoff / currentSampleRate));
+        }
+
+        tapLayoutTone = tone;
+    }
+
+    delayEngine->setTaps(tapLayout);
+    delayEngineDouble->setTaps(tapLayout);
+}
+
+void DelayWaveProcessor::updateFeedbackMatrix(bool midSide)
+{
+    const int feedbackMode = static_cast<int>(apvts.getRawParameterValue(ParamIDs::feedbackMode)->load());
+
+    // One matrix per group of four channels, built around the lanes that
+    // stay out of the mixing. Ping-pong falls back to per-channel feedback
+    // for a lone channel. In mid/side the matrices are converted, so the
+    // repeats still move between left and right.
+    for (int group = 0; group < numFeedbackGroups; ++group)
+    {
+        const auto fixedLanes = fixedFeedbackLanes[static_cast<size_t>(group)];
+        auto matrix = feedbackMode == 1 ? DelayWaveDSP::FeedbackMatrix::pingPong(fixedLanes)
+                    : feedbackMode == 2 ? DelayWaveDSP::FeedbackMatrix::diffuse(fixedLanes)
+                                        : DelayWaveDSP::FeedbackMatrix::identity();
+
+        if (midSide)
+            matrix = matrix.toMidSide();
+
+        delayEngine->setFeedbackMatrix(group, matrix);
+        delayEngineDouble->setFeedbackMatrix(group, matrix);
+    }
+}
+
+void DelayWaveProcessor::parameterChanged(const juce::String&, float)
+{
+    // Oversampling changes need a fresh prepareToPlay (allocation and a
+    // latency change), which is the host's to call: until then the audio
+    // thread keeps running the prepared settings. Reporting a latency
+    // change asks the host to restart processing, which prepares again.
+    // Hosts may lock or allocate when notified, so that is only done for
+    // changes made on the message thread; automation on the audio thread
+    // waits for the next prepare the host does anyway.
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        updateHostDisplay(juce::AudioProcessorListener::ChangeDetails().withLatencyChanged(true));
+}
+
+void DelayWaveProcessor::updateHostPosition(int numSamples)
+{
+    auto* playHead = getPlayHead();
+    if (playHead == nullptr)
+        return;
+
+    const auto position = playHead->getPosition();
+    if (! position.hasValue())
+        return;
+
+    if (const auto bpm = position->getBpm(); bpm.hasValue() && *bpm > 0.0)
+        hostBpm = *bpm;
+
+    const auto ppq = position->getPpqPosition();
+    const bool playing = position->getIsPlaying() && ppq.hasValue();
+
+    // Lock the LFO to the timeline whenever playback starts or jumps, so a
+    // pass from the same position renders the same modulation in realtime
+    // and offline. In between it runs on freely from the locked phase,
+    // which keeps it continuous through rate and tempo changes.
+    if (transport.update(playing, playing ? *ppq : 0.0, hostBpm.load(), numSamples, getSampleRate()))
+    {
+        const double cyclesPerBeat = apvts.getRawParameterValue(ParamIDs::modRate)->load() * 60.0 / hostBpm.load();
+        lfo.setPosition(*ppq * cyclesPerBeat);
+    }
+}
+
+double DelayWaveProcessor::getLongestDelayTimeMs() const
+{
+    return juce::jmax(static_cast<double>(apvts.getParameterRange(ParamIDs::time).end), maxSyncedDelaySeconds * 1000.0);
+}
+
+float DelayWaveProcessor::getTargetDelayTimeMs() const
+{
+    if (apvts.getRawParameterValue(ParamIDs::sync)->load() < 0.5f)
+        return apvts.getRawParameterValue(ParamIDs::time)->load();
+
+    // Tempo changes reach the engine through the time smoother, so ramps and
+    // jumps glide instead of stepping the read position. Synced times may
+    // go past the Time range, up to maxSyncedDelaySeconds (1/1 at 120 bpm);
+    // longer divisions at slow tempos are held there, which keeps the ring
+    // from growing to several seconds on every instance.
+    const int division = static_cast<int>(apvts.getRawParameterValue(ParamIDs::syncDivision)->load());
+    return static_cast<float>(juce::jmin(DelayWaveDSP::TempoSync::divisionToMs(division, hostBpm.load()),
+                                         maxSyncedDelaySeconds * 1000.0));
+}
+
+void DelayWaveProcessor::updateSmoothedTargets(bool snapToTarget)
+{
+    const std::pair<int, const char*> targets[] = {
+        { smoothTime,         ParamIDs::time },
+        { smoothFeedback,     ParamIDs::feedback },
+        { smoothMix,          ParamIDs::mix },
+        { smoothModRate,      ParamIDs::modRate },
+        { smoothModDepth,     ParamIDs::modDepth },
+        { smoothTone,         ParamIDs::tone },
+        { smoothSideTime,     ParamIDs::sideTime },
+        { smoothSideFeedback, ParamIDs::sideFeedback }
+    };
+
+    for (const auto& [index, paramId] : targets)
+    {
+        const float value = index == smoothTime ? getTargetDelayTimeMs()
+                                                : apvts.getRawParameterValue(paramId)->load();
+
+        if (snapToTarget)
+            smoothers.setCurrentAndTargetValue(index, value);
+        else
+            smoothers.setTargetValue(index, value);
+    }
+
+    // Jump mode's read heads settle on the new time the same way
+    if (snapToTarget)
+        readHeads.reset();
+}
+
 //==============================================================================
+// Tools that run the processor without a host (DELAYWAVE_HEADLESS) are
+// built without the WebView editor
+#if DELAYWAVE_HEADLESS
+bool DelayWaveProcessor::hasEditor() const { return false; }
+juce::AudioProcessorEditor* DelayWaveProcessor::createEditor() { return nullptr; }
+#else
 bool DelayWaveProcessor::hasEditor() const { return true; }
 
 juce::AudioProcessorEditor* DelayWaveProcessor::createEditor()
 {
     return new DelayWaveEditor(*this);
 }
+#endif
 
 //==============================================================================
 void DelayWaveProcessor::getStateInformation(juce::MemoryBlock& destData)
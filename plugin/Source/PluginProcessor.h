@@ -9,14 +9,27 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include <array>
 #include <memory>
+#include <vector>
+
+#include "DSP/BypassFader.h"
+#include "DSP/CpuLoadMeter.h"
+#include "DSP/DelayProcessor.h"
+#include "DSP/Lfo.h"
+#include "DSP/ModulationMatrix.h"
+#include "DSP/ReadHeadCrossfader.h"
+#include "DSP/SilenceDetector.h"
+#include "DSP/SmoothedParameterBank.h"
+#include "DSP/TempoSync.h"
 
 #if BEATCONNECT_ACTIVATION_ENABLED
 namespace beatconnect { class Activation; }
 #endif
 
 //==============================================================================
-class DelayWaveProcessor : public juce::AudioProcessor
+class DelayWaveProcessor : public juce::AudioProcessor,
+                           private juce::AudioProcessorValueTreeState::Listener
 {
 public:
     //==============================================================================
@@ -30,7 +43,8 @@ public:
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-    using AudioProcessor::processBlock;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -70,6 +84,26 @@ public:
     beatconnect::Activation* getActivation();
 #endif
 
+    //==============================================================================
+    // DSP kernel selection (scalar reference vs SIMD) for A/B comparisons
+    void setKernelMode(DelayWaveDSP::KernelMode mode) { kernelMode.store(mode); }
+    DelayWaveDSP::KernelMode getKernelMode() const { return kernelMode.load(); }
+
+    // Instruction set of the kernel variant picked for this CPU at startup
+    const char* getKernelInstructionSetName() const { return DelayWaveDSP::getInstructionSetName(delayEngine->getInstructionSet()); }
+
+    // Bytes of DSP state (delay memory and control buffers) held by this instance
+    size_t getDspMemoryUsage() const { return dspMemoryBytes.load(); }
+
+    // Tail sleep: whether the last block was skipped, and the fraction of
+    // audio since prepareToPlay that was processed awake (1 = never slept)
+    bool isSleeping() const { return sleeping.load(); }
+    float getActiveDutyCycle() const { return activeDutyCycle.load(); }
+
+    // Per-block CPU load against the block's deadline; off until enabled,
+    // read and reset from any thread
+    DelayWaveDSP::CpuLoadMeter& getCpuLoadMeter() { return cpuLoadMeter; }
+
 private:
     //==============================================================================
     // Parameters
@@ -90,26 +124,121 @@ private:
 
     //==============================================================================
     // DSP - Delay line with modulation
-    static constexpr float maxDelaySeconds = 2.0f;
+    static constexpr float maxSyncedDelaySeconds = 2.0f;    // Synced times are clamped to this
+    static constexpr float maxModulationSeconds = 0.02f;    // Up to 20ms of wobble
+    static constexpr float lowCutOffHz = 20.0f;             // Low Cut at this value is off
+    static constexpr double diffusionTailSeconds = 0.1;     // How far the diffuser smears each repeat
+
+    // The best kernel variant for this CPU (see DSP/DelayKernels.cpp)
+    std::unique_ptr<DelayWaveDSP::DelayProcessor<float>> delayEngine { DelayWaveDSP::createDelayProcessor<float>() };
+    std::unique_ptr<DelayWaveDSP::DelayProcessor<double>> delayEngineDouble { DelayWaveDSP::createDelayProcessor<double>() };    // Used when the host processes in double
+
+    // Per group of four channels, the lanes that keep their own feedback in
+    // ping-pong and diffuse modes, from the bus layout in prepareToPlay
+    static constexpr int maxFeedbackGroups = DelayWaveDSP::DelayProcessor<>::maxChannels / DelayWaveDSP::FeedbackMatrix::size;
+    std::array<unsigned int, maxFeedbackGroups> fixedFeedbackLanes {};
+    int numFeedbackGroups = 0;
+
+#if DELAYWAVE_SCALAR_KERNEL
+    std::atomic<DelayWaveDSP::KernelMode> kernelMode { DelayWaveDSP::KernelMode::Scalar };
+#else
+    std::atomic<DelayWaveDSP::KernelMode> kernelMode { DelayWaveDSP::KernelMode::Simd };
+#endif
+
+    // Per-sample control data handed to the engine, sized in prepareToPlay
+    std::vector<float> baseDelayBuffer;
+    std::vector<float> sideDelayBuffer;     // Side channel time in mid/side
+    std::vector<float> modAmountBuffer;
+    std::vector<float> delayBuffers;    // Read positions, maxControlBlockSize per channel
+    int maxControlBlockSize = 0;
 
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> delayLineL;
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> delayLineR;
+    // Jump mode: time changes crossfade to a second read head instead of
+    // sliding the first one
+    DelayWaveDSP::ReadHeadCrossfader readHeads;
+    std::vector<float> jumpFadeBuffer;
+    std::vector<float> jumpDelayBuffers;    // Second head's read positions, laid out like delayBuffers
+    bool jumpMode = false;
+
+    std::atomic<size_t> dspMemoryBytes { 0 };
+
+    // Tail sleep
+    DelayWaveDSP::SilenceDetector silenceDetector;
+    float blockWritePeak = 0.0f;        // Peak written into the delay during the current block
+    std::atomic<bool> sleeping { false };
+    std::atomic<float> activeDutyCycle { 1.0f };
+
+    DelayWaveDSP::CpuLoadMeter cpuLoadMeter;
+
+    // Bypass crossfade; the dry copy is only used by the ring out policy
+    DelayWaveDSP::BypassFader bypassFader;
+    std::vector<float> bypassGainBuffer;
+    std::vector<float> bypassMixBuffer;
+    juce::AudioBuffer<float> bypassDryBuffer;
+    juce::AudioBuffer<double> bypassDryBufferDouble;
+    bool delayFlushed = false;          // Delay cleared since it last ran
 
     // LFO for modulation
-    float lfoPhase = 0.0f;
+    DelayWaveDSP::Lfo lfo;
     double currentSampleRate = 44100.0;
 
+    // Modulation matrix, evaluated every modControlInterval host samples.
+    // Each destination's -1 to 1 sum is scaled by its range below.
+    static constexpr int modControlInterval = 32;
+    static constexpr float modTimeRange = 0.5f;         // Fraction of the delay time
+    static constexpr float modFeedbackRange = 0.5f;
+    static constexpr float modToneRange = 0.5f;         // Of the Tone control
+    static constexpr float modMixRange = 0.5f;
+
+    DelayWaveDSP::ModulationMatrix modulation;
+    std::vector<float> modFeedbackBuffer;
+    std::vector<float> modSideFeedbackBuffer;
+    std::vector<float> modMixBuffer;
+    void updateModulationMatrix();
+
     // Smoothed parameter values (prevent clicks)
-    juce::SmoothedValue<float> smoothedTime;
-    juce::SmoothedValue<float> smoothedFeedback;
-    juce::SmoothedValue<float> smoothedMix;
-    juce::SmoothedValue<float> smoothedModRate;
-    juce::SmoothedValue<float> smoothedModDepth;
-    juce::SmoothedValue<float> smoothedTone;
-
-    // Simple lowpass filter for tone control
-    float filterStateL = 0.0f;
-    float filterStateR = 0.0f;
+    enum SmoothedParam
+    {
+        smoothTime,
+        smoothFeedback,
+        smoothMix,
+        smoothModRate,
+        smoothModDepth,
+        smoothTone,
+        smoothSideTime,
+        smoothSideFeedback,
+        numSmoothedParams
+    };
+
+    DelayWaveDSP::SmoothedParameterBank smoothers;
+    void updateSmoothedTargets(bool snapToTarget);
+
+    // Host tempo sync
+    DelayWaveDSP::TransportFollower transport;
+    std::atomic<double> hostBpm { 120.0 };  // Last tempo reported by the host, also read by getTailLengthSeconds()
+
+    void updateHostPosition(int numSamples);
+    float getTargetDelayTimeMs() const;
+    double getLongestDelayTimeMs() const;   // The end of the Time range or the longest synced time
+
+    // Oversampling (created in prepareToPlay for the selected factor)
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
+    std::unique_ptr<juce::dsp::Oversampling<double>> oversamplerDouble;
+    int activeOversampling = 0;         // log2 of the factor
+    int activeOversamplingFilter = 0;
+    int hostBlockSize = 0;
+
+    // Shared by the float and double processBlock
+    template <typename SampleType> void processSamples(juce::AudioBuffer<SampleType>& buffer);
+    template <typename SampleType> void processDelay(SampleType* const* channels, int numChannels, int numSamples);
+    template <typename SampleType> DelayWaveDSP::DelayProcessor<SampleType>& getDelayEngine();
+    template <typename SampleType> std::unique_ptr<juce::dsp::Oversampling<SampleType>>& getOversampler();
+    template <typename SampleType> juce::AudioBuffer<SampleType>& getBypassDryBuffer();
+    template <typename SampleType> void processBypassed(juce::AudioBuffer<SampleType>& buffer, int numChannels);
+    void updateTapLayout();
+    DelayWaveDSP::TapLayout tapLayout;
+    float tapLayoutTone = -1.0f;    // Tone the tap filters were worked out for; negative before the first block
+    void updateFeedbackMatrix(bool midSide);
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
 
     //==============================================================================
     // Level metering
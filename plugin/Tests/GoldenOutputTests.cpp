@@ -0,0 +1,393 @@
+/*
+  ==============================================================================
+    DelayWave - Golden Output Tests
+    Renders fixed stimuli (an impulse, a sweep, noise, silence then signal)
+    through DelayWaveProcessor with a set of parameter snapshots, and
+    compares each render against a stored golden file in Tests/Golden.
+
+    The goldens are rendered with the scalar reference kernel, so that path
+    has to match them bit for bit. The SIMD kernels are compared against
+    the same files within each case's tolerance: a sample passes when it
+    is within maxUlps of the golden, or when its error is at least
+    maxErrorDb below the golden's peak.
+
+    Set DELAYWAVE_GOLDEN_RECORD=1 (or build the DelayWaveGoldenRecord
+    target) to write new goldens instead of comparing. Only do that when
+    a change to the output is intended, and say so in the commit. The
+    goldens are recorded on Linux x86-64; other compilers and maths
+    libraries may round the processor's non-kernel code differently.
+  ==============================================================================
+*/
+
+#include "../Source/PluginProcessor.h"
+#include "../Source/ParameterIDs.h"
+#include "../Tools/Common/OfflineHost.h"
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 256;
+    constexpr int numChannels = 2;
+    constexpr double renderSeconds = 1.0;
+    constexpr double testBpm = 120.0;
+
+    enum class Stimulus
+    {
+        Impulse,
+        Sweep,              // Exponential, 20 Hz to 20 kHz
+        Noise,
+        SilenceToSignal     // Wakes the engine from its silent sleep
+    };
+
+    struct Setting
+    {
+        const char* id;
+        float value;        // In the parameter's own units, choices by index
+    };
+
+    struct Tolerance
+    {
+        std::int64_t maxUlps;
+        float maxErrorDb;   // Relative to the golden's peak
+    };
+
+    struct GoldenCase
+    {
+        const char* name;
+        Stimulus stimulus;
+        std::vector<Setting> settings;      // Before prepareToPlay
+        std::vector<Setting> automation;    // Halfway through the render
+        Tolerance simdTolerance;
+    };
+
+    const Tolerance bitExact { 0, -std::numeric_limits<float>::infinity() };
+    const Tolerance rounding { 4, -120.0f };
+    const Tolerance amplified { 64, -100.0f };  // Saturation or long feedback amplify rounding
+
+    const std::vector<GoldenCase>& getGoldenCases()
+    {
+        static const std::vector<GoldenCase> cases {
+            { "impulse_default", Stimulus::Impulse, {}, {}, rounding },
+
+            { "impulse_pingpong", Stimulus::Impulse,
+              { { ParamIDs::feedbackMode, 1 }, { ParamIDs::time, 180 } }, {}, rounding },
+
+            { "impulse_diffuse", Stimulus::Impulse,
+              { { ParamIDs::feedbackMode, 2 }, { ParamIDs::diffusion, 0.7f }, { ParamIDs::diffusionStages, 8 } }, {}, rounding },
+
+            { "impulse_multitap", Stimulus::Impulse,
+              { { ParamIDs::taps, 4 }, { ParamIDs::tapDecay, 0.5f }, { ParamIDs::tapSpread, 0.8f } }, {}, rounding },
+
+            { "impulse_jump", Stimulus::Impulse,
+              { { ParamIDs::timeMode, 1 }, { ParamIDs::time, 150 }, { ParamIDs::feedback, 0.7f } },
+              { { ParamIDs::time, 240 } }, rounding },
+
+            { "sweep_tape", Stimulus::Sweep,
+              { { ParamIDs::feedback, 0.8f }, { ParamIDs::modDepth, 0.6f }, { ParamIDs::modRate, 2 },
+                { ParamIDs::saturationMode, 2 }, { ParamIDs::saturation, 6 } }, {}, amplified },
+
+            { "sweep_tone", Stimulus::Sweep,
+              { { ParamIDs::tone, 0.3f }, { ParamIDs::toneSlope, 1 }, { ParamIDs::lowCut, 200 } }, {}, rounding },
+
+            { "noise_midside", Stimulus::Noise,
+              { { ParamIDs::midSide, 1 }, { ParamIDs::sideTime, 220 }, { ParamIDs::sideFeedback, 0.6f } }, {}, rounding },
+
+            // LFO 2 to feedback, envelope to tone
+            { "noise_modmatrix", Stimulus::Noise,
+              { { ParamIDs::modSource[0], 2 }, { ParamIDs::modDestination[0], 1 }, { ParamIDs::modAmount[0], 0.5f },
+                { ParamIDs::modSource[1], 3 }, { ParamIDs::modDestination[1], 2 }, { ParamIDs::modAmount[1], -0.4f } }, {}, rounding },
+
+            { "noise_oversampled", Stimulus::Noise,
+              { { ParamIDs::oversampling, 1 }, { ParamIDs::saturationMode, 1 }, { ParamIDs::saturation, 9 } }, {}, amplified },
+
+            { "noise_maxfeedback", Stimulus::Noise,
+              { { ParamIDs::feedback, 0.95f }, { ParamIDs::time, 90 } }, {}, amplified },
+
+            { "silence_to_signal", Stimulus::SilenceToSignal, {}, {}, rounding },
+        };
+
+        return cases;
+    }
+
+    //==============================================================================
+    juce::AudioBuffer<float> makeStimulus(Stimulus stimulus, int numSamples)
+    {
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        buffer.clear();
+
+        const int half = numSamples / 2;
+        const double twoPi = juce::MathConstants<double>::twoPi;
+
+        switch (stimulus)
+        {
+            case Stimulus::Impulse:
+                for (int ch = 0; ch < numChannels; ++ch)
+                    buffer.setSample(ch, 0, 1.0f);
+                break;
+
+            case Stimulus::Sweep:
+            {
+                const double length = half / sampleRate;
+                const double octaves = std::log(20000.0 / 20.0);
+
+                for (int i = 0; i < half; ++i)
+                {
+                    const double t = i / sampleRate;
+                    const double phase = twoPi * 20.0 * length / octaves * (std::exp(t / length * octaves) - 1.0);
+
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        buffer.setSample(ch, i, static_cast<float>(0.5 * std::sin(phase)));
+                }
+                break;
+            }
+
+            case Stimulus::Noise:
+            {
+                juce::Random random(0x476f6c64);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    for (int i = 0; i < half; ++i)
+                        buffer.setSample(ch, i, 0.5f * random.nextFloat() - 0.25f);
+                break;
+            }
+
+            case Stimulus::SilenceToSignal:
+            {
+                const int burst = static_cast<int>(0.1 * sampleRate);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    for (int i = 0; i < burst; ++i)
+                        buffer.setSample(ch, half + i, static_cast<float>(0.5 * std::sin(twoPi * (440.0 + 220.0 * ch) * i / sampleRate)));
+                break;
+            }
+        }
+
+        return buffer;
+    }
+
+    //==============================================================================
+    // Distance in representable floats; adjacent floats are 1 apart
+    std::int64_t getUlpDistance(float a, float b)
+    {
+        if (std::isnan(a) || std::isnan(b))
+            return std::numeric_limits<std::int64_t>::max();
+
+        const auto ordered = [](float value)
+        {
+            std::int32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits < 0 ? static_cast<std::int64_t>(std::numeric_limits<std::int32_t>::min()) - bits
+                            : static_cast<std::int64_t>(bits);
+        };
+
+        return std::abs(ordered(a) - ordered(b));
+    }
+
+    struct Comparison
+    {
+        bool passed = true;
+        std::int64_t maxUlps = 0;
+        float maxErrorDb = -std::numeric_limits<float>::infinity();
+        int failedChannel = -1, failedSample = -1;      // The first sample out of tolerance
+    };
+
+    Comparison compare(const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& golden, const Tolerance& tolerance)
+    {
+        Comparison result;
+        const float peak = juce::jmax(1.0e-6f, golden.getMagnitude(0, golden.getNumSamples()));
+        const float allowedError = peak * std::pow(10.0f, tolerance.maxErrorDb / 20.0f);
+        float maxError = 0.0f;
+
+        for (int ch = 0; ch < golden.getNumChannels(); ++ch)
+        {
+            for (int i = 0; i < golden.getNumSamples(); ++i)
+            {
+                const float a = output.getSample(ch, i);
+                const float b = golden.getSample(ch, i);
+                const auto ulps = getUlpDistance(a, b);
+                const float error = std::abs(a - b);
+
+                result.maxUlps = juce::jmax(result.maxUlps, ulps);
+                maxError = std::isnan(error) ? std::numeric_limits<float>::infinity() : juce::jmax(maxError, error);
+
+                if (result.passed && ulps > tolerance.maxUlps && ! (error <= allowedError))
+                {
+                    result.passed = false;
+                    result.failedChannel = ch;
+                    result.failedSample = i;
+                }
+            }
+        }
+
+        if (maxError > 0.0f)
+            result.maxErrorDb = 20.0f * std::log10(maxError / peak);
+
+        return result;
+    }
+
+    //==============================================================================
+    juce::File getGoldenFile(const GoldenCase& goldenCase)
+    {
+        return juce::File(DELAYWAVE_GOLDEN_DIR).getChildFile(juce::String(goldenCase.name) + ".wav");
+    }
+
+    // 32-bit WAV, which JUCE writes as IEEE float, so every sample round trips exactly
+    bool writeGolden(const juce::File& file, const juce::AudioBuffer<float>& buffer)
+    {
+        file.deleteFile();
+        auto stream = file.createOutputStream();
+
+        if (stream == nullptr)
+            return false;
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, numChannels, 32, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        stream.release();   // Owned by the writer now
+        return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    }
+
+    std::optional<juce::AudioBuffer<float>> readGolden(const juce::File& file)
+    {
+        if (! file.existsAsFile())
+            return std::nullopt;
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+
+        if (reader == nullptr)
+            return std::nullopt;
+
+        juce::AudioBuffer<float> buffer(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+        reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+        return buffer;
+    }
+
+    //==============================================================================
+    class GoldenOutputTest final : public juce::UnitTest
+    {
+    public:
+        GoldenOutputTest() : juce::UnitTest("Golden output", "Golden") {}
+
+        void runTest() override
+        {
+            const bool recording = juce::SystemStats::getEnvironmentVariable("DELAYWAVE_GOLDEN_RECORD", "0") != "0";
+
+            for (const auto& goldenCase : getGoldenCases())
+            {
+                beginTest(goldenCase.name);
+
+                const auto scalar = render(goldenCase, DelayWaveDSP::KernelMode::Scalar);
+                const auto file = getGoldenFile(goldenCase);
+
+                if (recording)
+                {
+                    expect(writeGolden(file, scalar), "cannot write " + file.getFullPathName());
+                    logMessage("Recorded " + file.getFullPathName());
+                    continue;
+                }
+
+                const auto golden = readGolden(file);
+
+                if (! golden.has_value())
+                {
+                    expect(false, "no golden file " + file.getFullPathName() + "; record it with the DelayWaveGoldenRecord target");
+                    continue;
+                }
+
+                expectMatches(scalar, *golden, bitExact, "scalar");
+
+                DelayWaveProcessor processor;
+                expectMatches(render(goldenCase, DelayWaveDSP::KernelMode::Simd), *golden, goldenCase.simdTolerance,
+                              juce::String(processor.getKernelInstructionSetName()) + " SIMD");
+            }
+        }
+
+    private:
+        //==============================================================================
+        juce::AudioBuffer<float> render(const GoldenCase& goldenCase, DelayWaveDSP::KernelMode mode)
+        {
+            DelayWaveProcessor processor;
+            processor.setBusesLayout({ { juce::AudioChannelSet::stereo() }, { juce::AudioChannelSet::stereo() } });
+
+            for (const auto& setting : goldenCase.settings)
+                applySetting(processor, setting);
+
+            processor.setKernelMode(mode);
+
+            DelayWaveTools::OfflinePlayHead playHead(testBpm, sampleRate);
+            processor.setPlayHead(&playHead);
+            processor.setNonRealtime(true);
+            processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+            processor.prepareToPlay(sampleRate, blockSize);
+
+            const int numSamples = static_cast<int>(renderSeconds * sampleRate);
+            auto output = makeStimulus(goldenCase.stimulus, numSamples);
+            juce::AudioBuffer<float> buffer(numChannels, blockSize);
+            juce::MidiBuffer midi;
+
+            for (int start = 0; start < numSamples; start += blockSize)
+            {
+                const int count = juce::jmin(blockSize, numSamples - start);
+
+                if (start == numSamples / 2 / blockSize * blockSize)
+                    for (const auto& setting : goldenCase.automation)
+                        applySetting(processor, setting);
+
+                buffer.setSize(numChannels, count, false, false, true);
+                for (int ch = 0; ch < numChannels; ++ch)
+                    buffer.copyFrom(ch, 0, output, ch, start, count);
+
+                processor.processBlock(buffer, midi);
+                playHead.advance(count);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    output.copyFrom(ch, start, buffer, ch, 0, count);
+            }
+
+            processor.releaseResources();
+            return output;
+        }
+
+        void applySetting(juce::AudioProcessor& processor, const Setting& setting)
+        {
+            const auto error = DelayWaveTools::setParameter(processor, setting.id, setting.value);
+            expect(error.isEmpty(), error);
+        }
+
+        void expectMatches(const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& golden,
+                           const Tolerance& tolerance, const juce::String& kernel)
+        {
+            if (output.getNumChannels() != golden.getNumChannels() || output.getNumSamples() != golden.getNumSamples())
+            {
+                expect(false, kernel + ": the golden has " + juce::String(golden.getNumChannels()) + " channels of "
+                                  + juce::String(golden.getNumSamples()) + " samples, the render "
+                                  + juce::String(output.getNumChannels()) + " of " + juce::String(output.getNumSamples()));
+                return;
+            }
+
+            const auto result = compare(output, golden, tolerance);
+            const auto summary = kernel + ": max " + juce::String(result.maxUlps) + " ulps, max error "
+                               + juce::String(result.maxErrorDb, 1) + " dB";
+
+            logMessage(summary);
+            expect(result.passed, summary + "; first out of tolerance at channel " + juce::String(result.failedChannel)
+                                      + ", sample " + juce::String(result.failedSample));
+        }
+    };
+
+    GoldenOutputTest goldenOutputTest;
+}
@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+    DelayWave - Test Runner
+    Runs the juce::UnitTests linked into the executable, all of them or one
+    category, and exits with 1 if any expectation failed.
+
+    Usage:
+      <test executable> [category]
+  ==============================================================================
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    if (argc > 1)
+        runner.runTestsInCategory(argv[1]);
+    else
+        runner.runAllTests();
+
+    int numFailures = 0;
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        numFailures += runner.getResult(i)->failures;
+
+    return numFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,337 @@
+/*
+  ==============================================================================
+    DelayWave - Realtime Check
+    The interposed functions. The executable's definitions take precedence
+    over libc's for every library in the process, so JUCE and the C++
+    runtime go through them too. Each one checks the calling thread and
+    then forwards to libc: the allocator through its __libc_ entry points,
+    everything else through dlsym(RTLD_NEXT).
+  ==============================================================================
+*/
+
+#include "RealtimeCheck.h"
+
+#if defined(__linux__)
+ #include <features.h>     // Defines __GLIBC__
+#endif
+
+#if defined(__linux__) && defined(__GLIBC__)
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+}
+
+namespace
+{
+    // Trivial thread_locals, so reading them never allocates
+    thread_local int realtimeDepth = 0;
+    thread_local bool reporting = false;
+
+    std::atomic<int> numViolations { 0 };
+    std::atomic<bool> abortOnViolation { false };
+
+    void writeToStderr(const char* text) noexcept
+    {
+        [[maybe_unused]] const auto written = ::write(STDERR_FILENO, text, std::strlen(text));
+    }
+
+    // Called at the top of every interposed function
+    void check(const char* function) noexcept
+    {
+        if (realtimeDepth == 0 || reporting)
+            return;
+
+        // Reporting itself may allocate; that is not flagged again
+        reporting = true;
+        numViolations.fetch_add(1);
+
+        writeToStderr("Realtime violation: ");
+        writeToStderr(function);
+        writeToStderr("() called in a realtime section\n");
+
+        void* frames[64];
+        backtrace_symbols_fd(frames, backtrace(frames, 64), STDERR_FILENO);
+        writeToStderr("\n");
+
+        if (abortOnViolation.load())
+            std::abort();
+
+        reporting = false;
+    }
+
+    // libc's version of an interposed function, looked up once
+    void* next(std::atomic<void*>& cache, const char* name) noexcept
+    {
+        auto function = cache.load(std::memory_order_acquire);
+
+        if (function == nullptr)
+        {
+            // Not flagged if dlsym allocates
+            const bool wasReporting = reporting;
+            reporting = true;
+            function = dlsym(RTLD_NEXT, name);
+            reporting = wasReporting;
+            cache.store(function, std::memory_order_release);
+        }
+
+        return function;
+    }
+
+    // The first backtrace() loads the unwinder, which allocates; get that
+    // out of the way before any realtime section
+    struct Startup
+    {
+        Startup()
+        {
+            void* frames[1];
+            backtrace(frames, 1);
+
+            if (const char* value = std::getenv("DELAYWAVE_REALTIME_ABORT"))
+                abortOnViolation = std::strcmp(value, "0") != 0;
+        }
+    };
+
+    const Startup startup;
+}
+
+#define DELAYWAVE_FORWARD(name, ...) \
+    static std::atomic<void*> cache { nullptr }; \
+    return reinterpret_cast<decltype(&::name)>(next(cache, #name))(__VA_ARGS__)
+
+//==============================================================================
+// Heap
+extern "C"
+{
+    void* malloc(size_t size) noexcept
+    {
+        check("malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        check("calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size) noexcept
+    {
+        check("realloc");
+        return __libc_realloc(pointer, size);
+    }
+
+    void free(void* pointer) noexcept
+    {
+        if (pointer != nullptr)
+            check("free");
+
+        __libc_free(pointer);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        check("aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        check("posix_memalign");
+
+        if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+            return 22;  // EINVAL
+
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr || size == 0 ? 0 : 12;  // ENOMEM
+    }
+
+    //==============================================================================
+    // Locks, waits and sleeps. Try-locks never block, so they are allowed.
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        check("pthread_mutex_lock");
+        DELAYWAVE_FORWARD(pthread_mutex_lock, mutex);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t* lock) noexcept
+    {
+        check("pthread_rwlock_rdlock");
+        DELAYWAVE_FORWARD(pthread_rwlock_rdlock, lock);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t* lock) noexcept
+    {
+        check("pthread_rwlock_wrlock");
+        DELAYWAVE_FORWARD(pthread_rwlock_wrlock, lock);
+    }
+
+    int pthread_cond_wait(pthread_cond_t* condition, pthread_mutex_t* mutex)
+    {
+        check("pthread_cond_wait");
+        DELAYWAVE_FORWARD(pthread_cond_wait, condition, mutex);
+    }
+
+    int pthread_cond_timedwait(pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* time)
+    {
+        check("pthread_cond_timedwait");
+        DELAYWAVE_FORWARD(pthread_cond_timedwait, condition, mutex, time);
+    }
+
+    int pthread_join(pthread_t thread, void** result)
+    {
+        check("pthread_join");
+        DELAYWAVE_FORWARD(pthread_join, thread, result);
+    }
+
+    int sem_wait(sem_t* semaphore)
+    {
+        check("sem_wait");
+        DELAYWAVE_FORWARD(sem_wait, semaphore);
+    }
+
+    int nanosleep(const struct timespec* duration, struct timespec* remaining)
+    {
+        check("nanosleep");
+        DELAYWAVE_FORWARD(nanosleep, duration, remaining);
+    }
+
+    int usleep(useconds_t microseconds)
+    {
+        check("usleep");
+        DELAYWAVE_FORWARD(usleep, microseconds);
+    }
+
+    unsigned int sleep(unsigned int seconds)
+    {
+        check("sleep");
+        DELAYWAVE_FORWARD(sleep, seconds);
+    }
+
+    //==============================================================================
+    // Files. open() takes a mode only when it creates the file.
+    int open(const char* path, int flags, ...)
+    {
+        check("open");
+
+        va_list args;
+        va_start(args, flags);
+        const auto mode = va_arg(args, unsigned int);
+        va_end(args);
+
+        DELAYWAVE_FORWARD(open, path, flags, mode);
+    }
+
+    int open64(const char* path, int flags, ...)
+    {
+        check("open64");
+
+        va_list args;
+        va_start(args, flags);
+        const auto mode = va_arg(args, unsigned int);
+        va_end(args);
+
+        DELAYWAVE_FORWARD(open64, path, flags, mode);
+    }
+
+    FILE* fopen(const char* path, const char* mode)
+    {
+        check("fopen");
+        DELAYWAVE_FORWARD(fopen, path, mode);
+    }
+
+    FILE* fopen64(const char* path, const char* mode)
+    {
+        check("fopen64");
+        DELAYWAVE_FORWARD(fopen64, path, mode);
+    }
+
+    //==============================================================================
+    // Network
+    int socket(int domain, int type, int protocol) noexcept
+    {
+        check("socket");
+        DELAYWAVE_FORWARD(socket, domain, type, protocol);
+    }
+
+    int connect(int fd, const struct sockaddr* address, socklen_t length)
+    {
+        check("connect");
+        DELAYWAVE_FORWARD(connect, fd, address, length);
+    }
+
+    ssize_t send(int fd, const void* data, size_t length, int flags)
+    {
+        check("send");
+        DELAYWAVE_FORWARD(send, fd, data, length, flags);
+    }
+
+    ssize_t sendto(int fd, const void* data, size_t length, int flags, const struct sockaddr* address, socklen_t addressLength)
+    {
+        check("sendto");
+        DELAYWAVE_FORWARD(sendto, fd, data, length, flags, address, addressLength);
+    }
+
+    ssize_t recv(int fd, void* data, size_t length, int flags)
+    {
+        check("recv");
+        DELAYWAVE_FORWARD(recv, fd, data, length, flags);
+    }
+
+    ssize_t recvfrom(int fd, void* data, size_t length, int flags, struct sockaddr* address, socklen_t* addressLength)
+    {
+        check("recvfrom");
+        DELAYWAVE_FORWARD(recvfrom, fd, data, length, flags, address, addressLength);
+    }
+}
+
+#undef DELAYWAVE_FORWARD
+
+//==============================================================================
+namespace DelayWaveTests
+{
+    namespace RealtimeCheck
+    {
+        bool isAvailable() noexcept                         { return true; }
+        int getNumViolations() noexcept                     { return numViolations.load(); }
+        void resetViolations() noexcept                     { numViolations = 0; }
+        void setAbortOnViolation(bool shouldAbort) noexcept { abortOnViolation = shouldAbort; }
+        void enterRealtimeSection() noexcept                { ++realtimeDepth; }
+        void exitRealtimeSection() noexcept                 { --realtimeDepth; }
+    }
+}
+
+#else
+
+namespace DelayWaveTests
+{
+    namespace RealtimeCheck
+    {
+        bool isAvailable() noexcept             { return false; }
+        int getNumViolations() noexcept         { return 0; }
+        void resetViolations() noexcept         {}
+        void setAbortOnViolation(bool) noexcept {}
+        void enterRealtimeSection() noexcept    {}
+        void exitRealtimeSection() noexcept     {}
+    }
+}
+
+#endif
@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+    DelayWave - Realtime Check
+    Flags calls that have no place on the audio thread: heap allocation,
+    blocking locks, waits and sleeps, file and network access. Linked into
+    a test executable, RealtimeCheck.cpp interposes those functions; a call
+    made on a thread that is inside a realtime section (see ScopedSection)
+    is reported on stderr with a stack trace and counted.
+
+    Only for glibc on Linux. Everything else still runs, but nothing is
+    checked (isAvailable() is false).
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace DelayWaveTests
+{
+    namespace RealtimeCheck
+    {
+        bool isAvailable() noexcept;
+
+        // Calls flagged so far, on any thread
+        int getNumViolations() noexcept;
+        void resetViolations() noexcept;
+
+        // Aborts on the first violation instead of counting it (also set by
+        // DELAYWAVE_REALTIME_ABORT=1 in the environment)
+        void setAbortOnViolation(bool shouldAbort) noexcept;
+
+        void enterRealtimeSection() noexcept;
+        void exitRealtimeSection() noexcept;
+
+        // Marks the calling thread as the audio thread while in scope
+        struct ScopedSection
+        {
+            ScopedSection() noexcept { enterRealtimeSection(); }
+            ~ScopedSection() { exitRealtimeSection(); }
+
+            ScopedSection(const ScopedSection&) = delete;
+            ScopedSection& operator=(const ScopedSection&) = delete;
+        };
+    }
+}
@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+    DelayWave - Realtime Safety Tests
+    Runs the processor of the executable (whatever createPluginFilter()
+    returns) the way a host would, with every processBlock call inside a
+    realtime section, and expects RealtimeCheck to have flagged nothing:
+    no allocation, lock, wait, file or network call on the audio thread.
+
+    Host-side work stays outside the sections: prepareToPlay, state
+    changes, and parameter changes (JUCE takes a listener lock to announce
+    those, whichever thread the host sets them on).
+  ==============================================================================
+*/
+
+#include "../Tools/Common/OfflineHost.h"
+#include "RealtimeCheck/RealtimeCheck.h"
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include <memory>
+#include <type_traits>
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+namespace
+{
+    using DelayWaveTests::RealtimeCheck::ScopedSection;
+
+    constexpr double testBpm = 120.0;
+
+    class RealtimeSafetyTest final : public juce::UnitTest
+    {
+    public:
+        RealtimeSafetyTest() : juce::UnitTest("Realtime safety", "Realtime") {}
+
+        void runTest() override
+        {
+            if (! DelayWaveTests::RealtimeCheck::isAvailable())
+            {
+                logMessage("Realtime checks are not available on this platform; skipped");
+                return;
+            }
+
+            runAll<float>("float");
+
+            if (std::unique_ptr<juce::AudioProcessor>(createPluginFilter())->supportsDoublePrecisionProcessing())
+                runAll<double>("double");
+        }
+
+    private:
+        //==============================================================================
+        // A processor prepared the way a host does it, with a clock
+        template <typename SampleType>
+        struct Host
+        {
+            Host(double sampleRateToUse, int maxBlockSizeToUse)
+                : processor(createPluginFilter()),
+                  playHead(testBpm, sampleRateToUse),
+                  buffer(juce::jmax(1, processor->getTotalNumOutputChannels()), maxBlockSizeToUse),
+                  sampleRate(sampleRateToUse),
+                  maxBlockSize(maxBlockSizeToUse)
+            {
+                processor->setPlayHead(&playHead);
+                processor->setProcessingPrecision(std::is_same_v<SampleType, double> ? juce::AudioProcessor::doublePrecision
+                                                                                     : juce::AudioProcessor::singlePrecision);
+                processor->setRateAndBufferSizeDetails(sampleRate, maxBlockSize);
+                processor->prepareToPlay(sampleRate, maxBlockSize);
+            }
+
+            ~Host() { processor->releaseResources(); }
+
+            // One block of noise, processed in a realtime section
+            void process(int numSamples, juce::Random& random, bool bypassedByHost = false)
+            {
+                buffer.setSize(buffer.getNumChannels(), numSamples, false, false, true);
+
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    for (int i = 0; i < numSamples; ++i)
+                        buffer.setSample(ch, i, static_cast<SampleType>(0.5f * random.nextFloat() - 0.25f));
+
+                {
+                    const ScopedSection section;
+
+                    if (bypassedByHost)
+                        processor->processBlockBypassed(buffer, midi);
+                    else
+                        processor->processBlock(buffer, midi);
+                }
+
+                playHead.advance(numSamples);
+            }
+
+            void processFor(double seconds, juce::Random& random)
+            {
+                for (int done = 0; done < static_cast<int>(seconds * sampleRate); done += maxBlockSize)
+                    process(maxBlockSize, random);
+            }
+
+            std::unique_ptr<juce::AudioProcessor> processor;
+            DelayWaveTools::OfflinePlayHead playHead;
+            juce::AudioBuffer<SampleType> buffer;
+            juce::MidiBuffer midi;
+            double sampleRate;
+            int maxBlockSize;
+        };
+
+        //==============================================================================
+        template <typename SampleType>
+        void runAll(const juce::String& precision)
+        {
+            const auto name = juce::String(std::unique_ptr<juce::AudioProcessor>(createPluginFilter())->getName());
+
+            beginTest(name + ", " + precision + ": prepare and process");
+            checkPrepareAndProcess<SampleType>();
+
+            beginTest(name + ", " + precision + ": varying block sizes");
+            checkVaryingBlockSizes<SampleType>();
+
+            beginTest(name + ", " + precision + ": automation");
+            checkAutomation<SampleType>();
+
+            beginTest(name + ", " + precision + ": state load");
+            checkStateLoad<SampleType>();
+
+            beginTest(name + ", " + precision + ": bypass toggles");
+            checkBypassToggles<SampleType>();
+        }
+
+        void expectNoViolations()
+        {
+            expectEquals(DelayWaveTests::RealtimeCheck::getNumViolations(), 0,
+                         "calls flagged on the audio thread (stack traces above)");
+            DelayWaveTests::RealtimeCheck::resetViolations();
+        }
+
+        //==============================================================================
+        template <typename SampleType>
+        void checkPrepareAndProcess()
+        {
+            auto random = getRandom();
+
+            for (const auto sampleRate : { 44100.0, 96000.0 })
+            {
+                for (const auto blockSize : { 1, 64, 480, 512 })
+                {
+                    DelayWaveTests::RealtimeCheck::resetViolations();
+                    Host<SampleType> host(sampleRate, blockSize);
+                    host.processFor(0.5, random);
+                    expectNoViolations();
+                }
+            }
+        }
+
+        // Hosts may send any block size up to the prepared one
+        template <typename SampleType>
+        void checkVaryingBlockSizes()
+        {
+            auto random = getRandom();
+            DelayWaveTests::RealtimeCheck::resetViolations();
+            Host<SampleType> host(48000.0, 512);
+
+            for (int block = 0; block < 500; ++block)
+                host.process(1 + random.nextInt(host.maxBlockSize), random);
+
+            expectNoViolations();
+        }
+
+        // Every parameter, random values, a few changes between blocks
+        template <typename SampleType>
+        void checkAutomation()
+        {
+            auto random = getRandom();
+            DelayWaveTests::RealtimeCheck::resetViolations();
+            Host<SampleType> host(48000.0, 256);
+            const auto& parameters = host.processor->getParameters();
+
+            for (int block = 0; block < 1000; ++block)
+            {
+                for (int change = 0; change < 4; ++change)
+                    parameters[random.nextInt(parameters.size())]->setValueNotifyingHost(random.nextFloat());
+
+                host.process(host.maxBlockSize, random);
+            }
+
+            expectNoViolations();
+        }
+
+        // Presets recalled while playing: every parameter moved at once
+        template <typename SampleType>
+        void checkStateLoad()
+        {
+            auto random = getRandom();
+            DelayWaveTests::RealtimeCheck::resetViolations();
+            Host<SampleType> host(48000.0, 256);
+
+            juce::MemoryBlock defaults;
+            host.processor->getStateInformation(defaults);
+
+            for (int preset = 0; preset < 20; ++preset)
+            {
+                for (auto* parameter : host.processor->getParameters())
+                    parameter->setValueNotifyingHost(random.nextFloat());
+
+                juce::MemoryBlock state;
+                host.processor->getStateInformation(state);
+
+                host.processor->setStateInformation(defaults.getData(), static_cast<int>(defaults.getSize()));
+                host.processFor(0.05, random);
+
+                host.processor->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+                host.processFor(0.05, random);
+            }
+
+            expectNoViolations();
+        }
+
+        // The plugin's bypass parameter, flipped mid-fade and after it,
+        // and the host's own bypass
+        template <typename SampleType>
+        void checkBypassToggles()
+        {
+            auto random = getRandom();
+            DelayWaveTests::RealtimeCheck::resetViolations();
+            Host<SampleType> host(48000.0, 128);
+            auto* bypass = DelayWaveTools::findParameter(*host.processor, "bypass");
+            auto* bypassTail = DelayWaveTools::findParameter(*host.processor, "bypassTail");
+
+            for (int toggle = 0; toggle < 200; ++toggle)
+            {
+                if (bypass != nullptr)
+                    bypass->setValueNotifyingHost(toggle % 2 == 0 ? 1.0f : 0.0f);
+
+                if (bypassTail != nullptr && toggle % 8 == 0)
+                    bypassTail->setValueNotifyingHost(bypassTail->getValue() < 0.5f ? 1.0f : 0.0f);
+
+                for (int block = random.nextInt(20); block >= 0; --block)
+                    host.process(host.maxBlockSize, random, toggle % 16 == 15);
+            }
+
+            expectNoViolations();
+        }
+    };
+
+    RealtimeSafetyTest realtimeSafetyTest;
+}
@@ -0,0 +1,429 @@
+/*
+  ==============================================================================
+    DelayWave - processBlock Benchmark
+    Drives DelayWaveProcessor::processBlock over a matrix of sample rates,
+    block sizes and parameter scenarios, and reports the cost per sample
+    frame (all channels together): nanoseconds, cycles and instructions per
+    cycle. Each case gets a fresh processor, a warm-up, then several timed
+    runs over the same noise input; the median run is reported, with the
+    fastest alongside.
+
+    The timed loop is what a host does per block: copy the input in, apply
+    the automation for the block (the "automated" scenario only) and call
+    processBlock.
+
+    Scenarios:
+      static        Default settings, nothing moves
+      automated     Time, feedback, mix and tone swept every block
+      bypass        Bypassed, settled
+      noModulation  Mod depth 0 (the steady-state delay paths)
+      maxFeedback   Feedback at its maximum
+
+    Usage:
+      DelayWaveBenchmark [options]
+
+      --rates <list>        Sample rates, e.g. 44100,96000 (default 44.1 to 192 kHz)
+      --blocks <list>       Block sizes, e.g. 1,64,441 (default 1 to 4096)
+      --scenarios <list>    Scenario names (default: all)
+      --set <id>=<value>    Set a parameter for every case; repeatable
+      --channels <count>    Channels (default 2)
+      --seconds <seconds>   Audio per timed run (default 1)
+      --repeats <count>     Timed runs per case (default 5)
+      --double              Process in double precision
+      --json <file>         Write the results as JSON ("-" for stdout)
+  ==============================================================================
+*/
+
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/ParameterIDs.h"
+#include "../Common/OfflineHost.h"
+#include "PerfCounters.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    constexpr double warmUpSeconds = 0.5;
+    constexpr double automationCycleSeconds = 2.0;
+    constexpr double defaultBpm = 120.0;
+
+    const juce::StringArray allScenarios { "static", "automated", "bypass", "noModulation", "maxFeedback" };
+
+    //==============================================================================
+    struct BenchmarkSettings
+    {
+        juce::Array<double> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 };
+        juce::Array<int> blockSizes { 1, 7, 32, 64, 127, 128, 256, 441, 512, 1024, 1999, 4096 };
+        juce::StringArray scenarios = allScenarios;
+        juce::StringPairArray parameters;       // ID to value, applied to every case
+        int numChannels = 2;
+        double secondsPerRun = 1.0;
+        int numRepeats = 5;
+        bool useDouble = false;
+        juce::String jsonPath;
+    };
+
+    struct RunResult
+    {
+        double seconds = 0.0;
+        DelayWaveTools::PerfCounters::Counts counts;
+    };
+
+    struct CaseResult
+    {
+        juce::String scenario;
+        double sampleRate = 0.0;
+        int blockSize = 0;
+        juce::int64 numSamples = 0;             // Per timed run
+        RunResult median, fastest;
+    };
+
+    //==============================================================================
+    // Static settings for a scenario, applied before prepareToPlay
+    void applyScenario(juce::AudioProcessor& processor, const juce::String& scenario)
+    {
+        if (scenario == "bypass")
+            DelayWaveTools::setParameter(processor, ParamIDs::bypass, 1.0f);
+        else if (scenario == "noModulation")
+            DelayWaveTools::setParameter(processor, ParamIDs::modDepth, 0.0f);
+        else if (scenario == "maxFeedback")
+            DelayWaveTools::findParameter(processor, ParamIDs::feedback)->setValueNotifyingHost(1.0f);
+    }
+
+    // The automated scenario's parameters, each swept by a sine over its
+    // whole range, a quarter cycle apart
+    struct Automation
+    {
+        explicit Automation(juce::AudioProcessor& processor)
+        {
+            for (const auto* id : { ParamIDs::time, ParamIDs::feedback, ParamIDs::mix, ParamIDs::tone })
+                parameters.add(DelayWaveTools::findParameter(processor, id));
+        }
+
+        void apply(juce::int64 samplePosition, double sampleRate)
+        {
+            const double phase = static_cast<double>(samplePosition) / (sampleRate * automationCycleSeconds);
+
+            for (int i = 0; i < parameters.size(); ++i)
+                parameters[i]->setValueNotifyingHost(static_cast<float>(0.5 + 0.5 * std::sin(juce::MathConstants<double>::twoPi * (phase + 0.25 * i))));
+        }
+
+        juce::Array<juce::RangedAudioParameter*> parameters;
+    };
+
+    //==============================================================================
+    template <typename SampleType>
+    CaseResult runCase(const BenchmarkSettings& settings, const juce::String& scenario, double sampleRate, int blockSize,
+                       DelayWaveTools::PerfCounters& counters)
+    {
+        CaseResult result;
+        result.scenario = scenario;
+        result.sampleRate = sampleRate;
+        result.blockSize = blockSize;
+
+        // Whole blocks only, so every call sees the full block size
+        const auto wholeBlocks = [blockSize](double seconds, double rate)
+        {
+            const auto blocks = static_cast<juce::int64>(std::ceil(seconds * rate / blockSize));
+            return juce::jmax(static_cast<juce::int64>(1), blocks) * blockSize;
+        };
+
+        result.numSamples = wholeBlocks(settings.secondsPerRun, sampleRate);
+
+        DelayWaveProcessor processor;
+        const auto channelSet = DelayWaveTools::getChannelSet(settings.numChannels);
+
+        if (! processor.setBusesLayout({ { channelSet }, { channelSet } }))
+            juce::ConsoleApplication::fail(juce::String(settings.numChannels) + " channels are not supported");
+
+        for (const auto& id : settings.parameters.getAllKeys())
+        {
+            const auto error = DelayWaveTools::setParameter(processor, id, settings.parameters[id].getFloatValue());
+
+            if (error.isNotEmpty())
+                juce::ConsoleApplication::fail(error);
+        }
+
+        applyScenario(processor, scenario);
+
+        DelayWaveTools::OfflinePlayHead playHead(defaultBpm, sampleRate);
+        processor.setPlayHead(&playHead);
+        processor.setProcessingPrecision(std::is_same_v<SampleType, double> ? juce::AudioProcessor::doublePrecision
+                                                                            : juce::AudioProcessor::singlePrecision);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        // About a second of noise at -12 dB, looped; the same on every run
+        const int inputLength = static_cast<int>(wholeBlocks(1.0, sampleRate));
+        juce::AudioBuffer<SampleType> input(settings.numChannels, inputLength);
+        juce::Random random(0x44656c61);
+
+        for (int ch = 0; ch < settings.numChannels; ++ch)
+            for (int i = 0; i < inputLength; ++i)
+                input.setSample(ch, i, static_cast<SampleType>(0.25f * (2.0f * random.nextFloat() - 1.0f)));
+
+        juce::AudioBuffer<SampleType> buffer(settings.numChannels, blockSize);
+        juce::MidiBuffer midi;
+        Automation automation(processor);
+        const bool automated = scenario == "automated";
+        juce::int64 position = 0;
+
+        const auto processFor = [&](juce::int64 numSamples)
+        {
+            for (juce::int64 done = 0; done < numSamples; done += blockSize)
+            {
+                const int inputPos = static_cast<int>(position % inputLength);
+
+                for (int ch = 0; ch < settings.numChannels; ++ch)
+                    buffer.copyFrom(ch, 0, input, ch, inputPos, blockSize);
+
+                if (automated)
+                    automation.apply(position, sampleRate);
+
+                processor.processBlock(buffer, midi);
+                playHead.advance(blockSize);
+                position += blockSize;
+            }
+        };
+
+        processFor(wholeBlocks(warmUpSeconds, sampleRate));
+
+        std::vector<RunResult> runs;
+
+        for (int run = 0; run < settings.numRepeats; ++run)
+        {
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            counters.start();
+            processFor(result.numSamples);
+            const auto counts = counters.stop();
+
+            runs.push_back({ juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks), counts });
+        }
+
+        processor.releaseResources();
+
+        std::sort(runs.begin(), runs.end(), [](const RunResult& a, const RunResult& b) { return a.seconds < b.seconds; });
+        result.fastest = runs.front();
+        result.median = runs[runs.size() / 2];
+        return result;
+    }
+
+    //==============================================================================
+    double perSample(double value, const CaseResult& result) { return value / static_cast<double>(result.numSamples); }
+
+    juce::var toJson(const CaseResult& result, const DelayWaveTools::PerfCounters& counters)
+    {
+        const auto& median = result.median;
+        auto* object = new juce::DynamicObject();
+
+        object->setProperty("scenario", result.scenario);
+        object->setProperty("sampleRate", result.sampleRate);
+        object->setProperty("blockSize", result.blockSize);
+        object->setProperty("samplesPerRun", result.numSamples);
+        object->setProperty("nsPerSample", perSample(median.seconds * 1.0e9, result));
+        object->setProperty("nsPerSampleFastest", perSample(result.fastest.seconds * 1.0e9, result));
+        object->setProperty("realtimeFactor", static_cast<double>(result.numSamples) / result.sampleRate / median.seconds);
+
+        const bool hasCycles = counters.getCycleSource() != DelayWaveTools::PerfCounters::CycleSource::None;
+        const bool hasInstructions = counters.countsInstructions() && median.counts.cycles > 0;
+
+        object->setProperty("cyclesPerSample", hasCycles ? juce::var(perSample(static_cast<double>(median.counts.cycles), result)) : juce::var());
+        object->setProperty("instructionsPerCycle", hasInstructions ? juce::var(static_cast<double>(median.counts.instructions) / static_cast<double>(median.counts.cycles))
+                                                                    : juce::var());
+        return object;
+    }
+
+    juce::String getCycleSourceName(DelayWaveTools::PerfCounters::CycleSource source)
+    {
+        switch (source)
+        {
+            case DelayWaveTools::PerfCounters::CycleSource::Core:       return "core";
+            case DelayWaveTools::PerfCounters::CycleSource::TimeStamp:  return "tsc";
+            case DelayWaveTools::PerfCounters::CycleSource::None:       break;
+        }
+
+        return "none";
+    }
+
+    //==============================================================================
+    template <typename Type>
+    juce::Array<Type> parseList(const juce::String& text)
+    {
+        juce::Array<Type> values;
+
+        for (const auto& item : juce::StringArray::fromTokens(text, ",", {}))
+        {
+            if constexpr (std::is_same_v<Type, int>)
+                values.add(item.getIntValue());
+            else
+                values.add(item.getDoubleValue());
+        }
+
+        return values;
+    }
+
+    void parseArguments(const juce::ArgumentList& args, BenchmarkSettings& settings)
+    {
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const auto& arg = args[i];
+            const auto next = [&]() -> juce::String
+            {
+                if (i + 1 >= args.size())
+                    juce::ConsoleApplication::fail("missing value after " + arg.text);
+
+                return args[++i].text;
+            };
+
+            if (arg == "--rates")
+            {
+                settings.sampleRates = parseList<double>(next());
+            }
+            else if (arg == "--blocks")
+            {
+                settings.blockSizes = parseList<int>(next());
+            }
+            else if (arg == "--scenarios")
+            {
+                settings.scenarios = juce::StringArray::fromTokens(next(), ",", {});
+
+                for (const auto& scenario : settings.scenarios)
+                    if (! allScenarios.contains(scenario))
+                        juce::ConsoleApplication::fail("unknown scenario " + scenario + " (expected " + allScenarios.joinIntoString(", ") + ")");
+            }
+            else if (arg == "--set")
+            {
+                const auto assignment = next();
+                if (! assignment.containsChar('='))
+                    juce::ConsoleApplication::fail("expected --set <id>=<value>, got " + assignment);
+
+                settings.parameters.set(assignment.upToFirstOccurrenceOf("=", false, false).trim(),
+                                        assignment.fromFirstOccurrenceOf("=", false, false).trim());
+            }
+            else if (arg == "--channels")
+            {
+                settings.numChannels = juce::jlimit(1, DelayWaveDSP::DelayProcessor<>::maxChannels, next().getIntValue());
+            }
+            else if (arg == "--seconds")
+            {
+                settings.secondsPerRun = juce::jlimit(0.01, 60.0, next().getDoubleValue());
+            }
+            else if (arg == "--repeats")
+            {
+                settings.numRepeats = juce::jlimit(1, 100, next().getIntValue());
+            }
+            else if (arg == "--double")
+            {
+                settings.useDouble = true;
+            }
+            else if (arg == "--json")
+            {
+                settings.jsonPath = next();
+            }
+            else
+            {
+                juce::ConsoleApplication::fail("unknown option " + arg.text);
+            }
+        }
+
+        for (const auto rate : settings.sampleRates)
+            if (rate < 8000.0 || rate > 384000.0)
+                juce::ConsoleApplication::fail("sample rate out of range: " + juce::String(rate));
+
+        for (const auto size : settings.blockSizes)
+            if (size < 1 || size > 65536)
+                juce::ConsoleApplication::fail("block size out of range: " + juce::String(size));
+    }
+
+    int run(const juce::ArgumentList& args)
+    {
+        BenchmarkSettings settings;
+        parseArguments(args, settings);
+
+        // Tables go to stderr when the JSON takes stdout
+        const bool jsonToStdout = settings.jsonPath == "-";
+        auto& log = jsonToStdout ? std::cerr : std::cout;
+
+        DelayWaveTools::PerfCounters counters;
+        juce::String kernel;
+        {
+            DelayWaveProcessor processor;
+            kernel = processor.getKernelInstructionSetName();
+        }
+
+        log << "DelayWave processBlock benchmark: " << kernel << " kernels, "
+            << (settings.useDouble ? "double" : "float") << ", " << settings.numChannels << " channels, cycles from "
+            << getCycleSourceName(counters.getCycleSource()) << "\n\n";
+
+        log << juce::String("scenario").paddedRight(' ', 14) << juce::String("rate").paddedLeft(' ', 8)
+            << juce::String("block").paddedLeft(' ', 7) << juce::String("ns/smp").paddedLeft(' ', 10)
+            << juce::String("cyc/smp").paddedLeft(' ', 10) << juce::String("IPC").paddedLeft(' ', 7)
+            << juce::String("x realtime").paddedLeft(' ', 12) << "\n";
+
+        juce::Array<juce::var> results;
+
+        for (const auto& scenario : settings.scenarios)
+        {
+            for (const auto rate : settings.sampleRates)
+            {
+                for (const auto blockSize : settings.blockSizes)
+                {
+                    const auto result = settings.useDouble ? runCase<double>(settings, scenario, rate, blockSize, counters)
+                                                           : runCase<float>(settings, scenario, rate, blockSize, counters);
+                    const auto json = toJson(result, counters);
+                    results.add(json);
+
+                    const auto format = [](const juce::var& value, int decimals)
+                    {
+                        return value.isVoid() ? juce::String("-") : juce::String(static_cast<double>(value), decimals);
+                    };
+
+                    log << scenario.paddedRight(' ', 14) << juce::String(rate, 0).paddedLeft(' ', 8)
+                        << juce::String(blockSize).paddedLeft(' ', 7)
+                        << format(json["nsPerSample"], 2).paddedLeft(' ', 10)
+                        << format(json["cyclesPerSample"], 1).paddedLeft(' ', 10)
+                        << format(json["instructionsPerCycle"], 2).paddedLeft(' ', 7)
+                        << format(json["realtimeFactor"], 1).paddedLeft(' ', 12) << "\n";
+                }
+            }
+        }
+
+        if (settings.jsonPath.isNotEmpty())
+        {
+            auto* report = new juce::DynamicObject();
+            report->setProperty("benchmark", "DelayWave processBlock");
+            report->setProperty("kernel", kernel);
+            report->setProperty("cpu", juce::SystemStats::getCpuModel());
+            report->setProperty("cycleSource", getCycleSourceName(counters.getCycleSource()));
+            report->setProperty("precision", settings.useDouble ? "double" : "float");
+            report->setProperty("channels", settings.numChannels);
+            report->setProperty("secondsPerRun", settings.secondsPerRun);
+            report->setProperty("repeats", settings.numRepeats);
+            report->setProperty("results", results);
+
+            const auto text = juce::JSON::toString(juce::var(report));
+
+            if (jsonToStdout)
+                std::cout << text << "\n";
+            else if (! juce::File::getCurrentWorkingDirectory().getChildFile(settings.jsonPath).replaceWithText(text))
+                juce::ConsoleApplication::fail("cannot write " + settings.jsonPath);
+        }
+
+        return 0;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    return juce::ConsoleApplication::invokeCatchingFailures([&]
+    {
+        return run(juce::ArgumentList(argc, argv));
+    });
+}
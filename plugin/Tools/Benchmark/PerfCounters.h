@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+    DelayWave - Performance Counters
+    Core cycles and retired instructions around a stretch of code. On Linux
+    they come from perf_event_open, counted for this thread only. Where
+    that is not available (another OS, or perf_event_paranoid forbids it)
+    x86 falls back to the time stamp counter for cycles, which ticks at a
+    fixed reference rate rather than the core clock, and instructions are
+    not counted.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(__linux__)
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+ #if defined(_MSC_VER)
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+namespace DelayWaveTools
+{
+    class PerfCounters
+    {
+    public:
+        enum class CycleSource
+        {
+            None,
+            Core,           // perf_event_open
+            TimeStamp       // rdtsc, reference cycles
+        };
+
+        struct Counts
+        {
+            std::uint64_t cycles = 0;
+            std::uint64_t instructions = 0;
+        };
+
+        PerfCounters()
+        {
+           #if defined(__linux__)
+            cyclesFd = open(PERF_COUNT_HW_CPU_CYCLES, -1);
+            if (cyclesFd >= 0)
+                instructionsFd = open(PERF_COUNT_HW_INSTRUCTIONS, cyclesFd);
+
+            if (cyclesFd >= 0 && instructionsFd >= 0)
+            {
+                cycleSource = CycleSource::Core;
+                return;
+            }
+
+            close();
+           #endif
+
+           #if defined(__x86_64__) || defined(_M_X64)
+            cycleSource = CycleSource::TimeStamp;
+           #endif
+        }
+
+        ~PerfCounters() { close(); }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        CycleSource getCycleSource() const noexcept { return cycleSource; }
+        bool countsInstructions() const noexcept { return cycleSource == CycleSource::Core; }
+
+        //==============================================================================
+        void start() noexcept
+        {
+           #if defined(__linux__)
+            if (cycleSource == CycleSource::Core)
+            {
+                ioctl(cyclesFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(cyclesFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                return;
+            }
+           #endif
+
+           #if defined(__x86_64__) || defined(_M_X64)
+            startStamp = __rdtsc();
+           #endif
+        }
+
+        Counts stop() noexcept
+        {
+            Counts counts;
+
+           #if defined(__linux__)
+            if (cycleSource == CycleSource::Core)
+            {
+                ioctl(cyclesFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+                // PERF_FORMAT_GROUP: the number of events, then one value each
+                std::uint64_t values[3] {};
+                if (read(cyclesFd, values, sizeof(values)) == static_cast<ssize_t>(sizeof(values)))
+                {
+                    counts.cycles = values[1];
+                    counts.instructions = values[2];
+                }
+
+                return counts;
+            }
+           #endif
+
+           #if defined(__x86_64__) || defined(_M_X64)
+            counts.cycles = __rdtsc() - startStamp;
+           #endif
+
+            return counts;
+        }
+
+    private:
+        //==============================================================================
+       #if defined(__linux__)
+        static int open(std::uint64_t config, int groupFd) noexcept
+        {
+            perf_event_attr attr {};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.disabled = groupFd < 0 ? 1 : 0;    // The group starts with its leader
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+        }
+
+        void close() noexcept
+        {
+            if (instructionsFd >= 0)
+                ::close(instructionsFd);
+
+            if (cyclesFd >= 0)
+                ::close(cyclesFd);
+
+            cyclesFd = instructionsFd = -1;
+        }
+
+        int cyclesFd = -1;
+        int instructionsFd = -1;
+       #else
+        void close() noexcept {}
+       #endif
+
+        CycleSource cycleSource = CycleSource::None;
+        std::uint64_t startStamp = 0;
+    };
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+    DelayWave - Offline Host
+    What the command line tools need to stand in for a host: a play head
+    with a fixed tempo, parameter lookup by ID, and bus layouts for a
+    channel count.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+namespace DelayWaveTools
+{
+    //==============================================================================
+    // A plain host clock: a fixed tempo and a position that follows the
+    // processed samples, so synced times and the LFO lock the same way on
+    // every run
+    class OfflinePlayHead final : public juce::AudioPlayHead
+    {
+    public:
+        OfflinePlayHead(double bpmToUse, double sampleRateToUse) : bpm(bpmToUse), sampleRate(sampleRateToUse) {}
+
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            PositionInfo info;
+            info.setBpm(bpm);
+            info.setTimeInSamples(samplePosition);
+            info.setTimeInSeconds(static_cast<double>(samplePosition) / sampleRate);
+            info.setPpqPosition(static_cast<double>(samplePosition) / sampleRate * bpm / 60.0);
+            info.setTimeSignature(juce::AudioPlayHead::TimeSignature {});
+            info.setIsPlaying(true);
+            return info;
+        }
+
+        void advance(int numSamples) { samplePosition += numSamples; }
+
+    private:
+        double bpm, sampleRate;
+        juce::int64 samplePosition = 0;
+    };
+
+    //==============================================================================
+    inline juce::RangedAudioParameter* findParameter(juce::AudioProcessor& processor, const juce::String& id)
+    {
+        for (auto* candidate : processor.getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(candidate))
+                if (ranged->getParameterID() == id)
+                    return ranged;
+
+        return nullptr;
+    }
+
+    // Sets a parameter in its own units (choices by index) the way a host
+    // automates it. Returns an error message, or an empty string.
+    inline juce::String setParameter(juce::AudioProcessor& processor, const juce::String& id, float value)
+    {
+        auto* parameter = findParameter(processor, id);
+
+        if (parameter == nullptr)
+            return "unknown parameter '" + id + "'";
+
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        return {};
+    }
+
+    inline juce::AudioChannelSet getChannelSet(int numChannels)
+    {
+        const auto set = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+        return set.isDisabled() ? juce::AudioChannelSet::discreteChannels(numChannels) : set;
+    }
+}
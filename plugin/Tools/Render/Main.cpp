@@ -0,0 +1,342 @@
+/*
+  ==============================================================================
+    DelayWave - Offline Render
+    Runs DelayWaveProcessor over audio files without a host, faster than
+    realtime. The settings come from a preset (the XML that
+    getStateInformation wraps) and/or single parameters. Files are rendered
+    in parallel, one processor per file, and each gets a line with its
+    realtime factor: seconds of audio per second of processing, counting
+    only the processBlock calls.
+
+    Usage:
+      DelayWaveRender [options] <input files...>
+
+      --preset <file.xml>   Load a preset (the plugin state as XML)
+      --set <id>=<value>    Set a parameter in its own units, e.g. time=250
+                            or feedbackMode=1 (choices by index); repeatable
+      --out <directory>     Where to write the results (default: next to
+                            each input, as <name>.render.<ext>)
+      --block <samples>     Block size (default 512)
+      --jobs <count>        Files rendered at once (default: one per core)
+      --tail <seconds>      Silence rendered after the input; "auto" uses
+                            the plugin's tail length, up to 30 s (default 0)
+      --bpm <tempo>         Host tempo for synced times (default 120)
+      --double              Process in double precision
+  ==============================================================================
+*/
+
+#include "../../Source/PluginProcessor.h"
+#include "../Common/OfflineHost.h"
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include <iostream>
+#include <type_traits>
+
+namespace
+{
+    constexpr double maxAutoTailSeconds = 30.0;
+
+    //==============================================================================
+    struct RenderSettings
+    {
+        std::unique_ptr<juce::XmlElement> preset;
+        juce::StringPairArray parameters;       // ID to value, applied after the preset
+        juce::File outputDirectory;
+        int blockSize = 512;
+        int numJobs = juce::SystemStats::getNumCpus();
+        double tailSeconds = 0.0;
+        bool autoTail = false;
+        double bpm = 120.0;
+        bool useDouble = false;
+    };
+
+    struct RenderResult
+    {
+        juce::File input, output;
+        juce::String error;
+        double audioSeconds = 0.0;
+        double processSeconds = 0.0;
+
+        double getRealtimeFactor() const { return processSeconds > 0.0 ? audioSeconds / processSeconds : 0.0; }
+    };
+
+    //==============================================================================
+    juce::String applySettings(juce::AudioProcessor& processor, const RenderSettings& settings)
+    {
+        if (settings.preset != nullptr)
+        {
+            juce::MemoryBlock state;
+            juce::AudioProcessor::copyXmlToBinary(*settings.preset, state);
+            processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        }
+
+        for (const auto& id : settings.parameters.getAllKeys())
+        {
+            const auto error = DelayWaveTools::setParameter(processor, id, settings.parameters[id].getFloatValue());
+
+            if (error.isNotEmpty())
+                return error;
+        }
+
+        return {};
+    }
+
+    juce::File getOutputFile(const juce::File& input, const RenderSettings& settings)
+    {
+        const auto name = input.getFileNameWithoutExtension() + ".render" + input.getFileExtension();
+        return settings.outputDirectory == juce::File() ? input.getSiblingFile(name)
+                                                        : settings.outputDirectory.getChildFile(name);
+    }
+
+    //==============================================================================
+    template <typename SampleType>
+    RenderResult renderFile(const juce::File& input, const RenderSettings& settings)
+    {
+        RenderResult result;
+        result.input = input;
+        result.output = getOutputFile(input, settings);
+
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(input));
+        if (reader == nullptr)
+        {
+            result.error = "cannot read this file";
+            return result;
+        }
+
+        const int numChannels = static_cast<int>(reader->numChannels);
+        const double sampleRate = reader->sampleRate;
+        const int blockSize = settings.blockSize;
+
+        DelayWaveProcessor processor;
+        const auto channelSet = DelayWaveTools::getChannelSet(numChannels);
+
+        if (numChannels > DelayWaveDSP::DelayProcessor<>::maxChannels
+            || ! processor.setBusesLayout({ { channelSet }, { channelSet } }))
+        {
+            result.error = juce::String(numChannels) + " channels are not supported";
+            return result;
+        }
+
+        result.error = applySettings(processor, settings);
+        if (result.error.isNotEmpty())
+            return result;
+
+        DelayWaveTools::OfflinePlayHead playHead(settings.bpm, sampleRate);
+        processor.setPlayHead(&playHead);
+        processor.setNonRealtime(true);
+        processor.setProcessingPrecision(std::is_same_v<SampleType, double> ? juce::AudioProcessor::doublePrecision
+                                                                            : juce::AudioProcessor::singlePrecision);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        // Oversampling delays the output; that much more is rendered and
+        // dropped from the start, so the result lines up with the input
+        const auto latency = static_cast<juce::int64>(processor.getLatencySamples());
+        const double tailSeconds = settings.autoTail ? juce::jmin(processor.getTailLengthSeconds(), maxAutoTailSeconds)
+                                                     : settings.tailSeconds;
+        const auto outputLength = reader->lengthInSamples + static_cast<juce::int64>(tailSeconds * sampleRate);
+
+        result.output.deleteFile();
+        auto stream = result.output.createOutputStream();
+        auto* format = formats.findFormatForFileExtension(result.output.getFileExtension());
+
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        if (stream != nullptr && format != nullptr)
+            writer.reset(format->createWriterFor(stream.get(), sampleRate, static_cast<unsigned int>(numChannels),
+                                                 static_cast<int>(reader->bitsPerSample), reader->metadataValues, 0));
+
+        if (writer == nullptr)
+        {
+            result.error = "cannot write " + result.output.getFullPathName();
+            return result;
+        }
+
+        stream.release();   // Owned by the writer now
+
+        juce::AudioBuffer<float> io(numChannels, blockSize);
+        juce::AudioBuffer<SampleType> buffer(numChannels, blockSize);
+        juce::MidiBuffer midi;
+        juce::int64 processTicks = 0;
+
+        for (juce::int64 position = 0; position < outputLength + latency; position += blockSize)
+        {
+            const int numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(blockSize), outputLength + latency - position));
+            io.clear();
+
+            // Past the end of the file the reader fills with silence
+            reader->read(&io, 0, numSamples, position, true, true);
+            buffer.makeCopyOf(io, true);
+            buffer.setSize(numChannels, numSamples, true, false, true);
+
+            const auto blockStart = juce::Time::getHighResolutionTicks();
+            processor.processBlock(buffer, midi);
+            processTicks += juce::Time::getHighResolutionTicks() - blockStart;
+            playHead.advance(numSamples);
+
+            // Skip the latency, then write what lies within the output
+            const auto skip = juce::jlimit(static_cast<juce::int64>(0), static_cast<juce::int64>(numSamples), latency - position);
+            const auto count = juce::jmin(static_cast<juce::int64>(numSamples) - skip, outputLength - juce::jmax(position, latency) + latency);
+
+            if (count > 0)
+            {
+                io.makeCopyOf(buffer, true);
+                writer->writeFromAudioSampleBuffer(io, static_cast<int>(skip), static_cast<int>(count));
+            }
+        }
+
+        processor.releaseResources();
+
+        result.audioSeconds = static_cast<double>(outputLength) / sampleRate;
+        result.processSeconds = juce::Time::highResolutionTicksToSeconds(processTicks);
+        return result;
+    }
+
+    //==============================================================================
+    bool parseArguments(const juce::ArgumentList& args, RenderSettings& settings, juce::Array<juce::File>& inputs)
+    {
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const auto& arg = args[i];
+            const auto next = [&]() -> juce::String
+            {
+                if (i + 1 >= args.size())
+                    juce::ConsoleApplication::fail("missing value after " + arg.text);
+
+                return args[++i].text;
+            };
+
+            if (arg == "--preset")
+            {
+                const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(next());
+                settings.preset = juce::XmlDocument::parse(file);
+
+                if (settings.preset == nullptr)
+                    juce::ConsoleApplication::fail("cannot parse preset " + file.getFullPathName());
+            }
+            else if (arg == "--set")
+            {
+                const auto assignment = next();
+                if (! assignment.containsChar('='))
+                    juce::ConsoleApplication::fail("expected --set <id>=<value>, got " + assignment);
+
+                settings.parameters.set(assignment.upToFirstOccurrenceOf("=", false, false).trim(),
+                                        assignment.fromFirstOccurrenceOf("=", false, false).trim());
+            }
+            else if (arg == "--out")
+            {
+                settings.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(next());
+            }
+            else if (arg == "--block")
+            {
+                settings.blockSize = juce::jlimit(16, 65536, next().getIntValue());
+            }
+            else if (arg == "--jobs")
+            {
+                settings.numJobs = juce::jmax(1, next().getIntValue());
+            }
+            else if (arg == "--tail")
+            {
+                const auto value = next();
+                settings.autoTail = value == "auto";
+                settings.tailSeconds = juce::jmax(0.0, value.getDoubleValue());
+            }
+            else if (arg == "--bpm")
+            {
+                settings.bpm = juce::jlimit(20.0, 999.0, next().getDoubleValue());
+            }
+            else if (arg == "--double")
+            {
+                settings.useDouble = true;
+            }
+            else if (arg.isOption())
+            {
+                juce::ConsoleApplication::fail("unknown option " + arg.text);
+            }
+            else
+            {
+                inputs.add(arg.resolveAsExistingFile());
+            }
+        }
+
+        return ! inputs.isEmpty();
+    }
+
+    int run(const juce::ArgumentList& args)
+    {
+        RenderSettings settings;
+        juce::Array<juce::File> inputs;
+
+        if (! parseArguments(args, settings, inputs))
+        {
+            std::cout << "Usage: " << args.executableName << " [--preset file.xml] [--set id=value ...] [--out dir]\n"
+                      << "       [--block n] [--jobs n] [--tail seconds|auto] [--bpm tempo] [--double] <input files...>\n";
+            return 1;
+        }
+
+        if (settings.outputDirectory != juce::File() && ! settings.outputDirectory.createDirectory())
+            juce::ConsoleApplication::fail("cannot create " + settings.outputDirectory.getFullPathName());
+
+        std::vector<RenderResult> results(static_cast<size_t>(inputs.size()));
+        juce::CriticalSection printLock;
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        {
+            juce::ThreadPool pool(juce::ThreadPoolOptions {}.withThreadName("DelayWaveRender")
+                                                             .withNumberOfThreads(juce::jmin(settings.numJobs, inputs.size())));
+
+            for (int i = 0; i < inputs.size(); ++i)
+            {
+                pool.addJob([&, i]
+                {
+                    auto& result = results[static_cast<size_t>(i)];
+                    result = settings.useDouble ? renderFile<double>(inputs[i], settings)
+                                                : renderFile<float>(inputs[i], settings);
+
+                    const juce::ScopedLock lock(printLock);
+
+                    if (result.error.isNotEmpty())
+                        std::cerr << result.input.getFullPathName() << ": " << result.error << "\n";
+                    else
+                        std::cout << result.input.getFileName() << ": " << juce::String(result.audioSeconds, 2) << " s in "
+                                  << juce::String(result.processSeconds, 3) << " s, "
+                                  << juce::String(result.getRealtimeFactor(), 1) << "x realtime -> "
+                                  << result.output.getFullPathName() << "\n";
+                });
+            }
+        }
+
+        double audioSeconds = 0.0, processSeconds = 0.0;
+        int failed = 0;
+
+        for (const auto& result : results)
+        {
+            audioSeconds += result.audioSeconds;
+            processSeconds += result.processSeconds;
+            failed += result.error.isNotEmpty() ? 1 : 0;
+        }
+
+        const double wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+        std::cout << (inputs.size() - failed) << " of " << inputs.size() << " files rendered in "
+                  << juce::String(wallSeconds, 2) << " s, "
+                  << juce::String(processSeconds > 0.0 ? audioSeconds / processSeconds : 0.0, 1)
+                  << "x realtime per job\n";
+
+        return failed == 0 ? 0 : 1;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    return juce::ConsoleApplication::invokeCatchingFailures([&]
+    {
+        return run(juce::ArgumentList(argc, argv));
+    });
+}
@@ -179,6 +179,68 @@ function Meter({ value, label }: { value: number; label: string }) {
   );
 }
 
+// ============================================================================
+// Performance Panel
+// ============================================================================
+
+interface PerformanceData {
+  blocks: number;
+  minLoad: number;
+  meanLoad: number;
+  p99Load: number;
+  maxLoad: number;
+  overruns: number;
+  totalOverruns: number;
+  counter: string;
+  kernel: string;
+}
+
+// CPU load per block, as a percentage of the block's deadline. The plugin
+// only measures while this panel is open.
+function PerformancePanel() {
+  const [perf, setPerf] = useState<PerformanceData | null>(null);
+
+  useEffect(() => {
+    const unsub = addEventListener('performance', (data: unknown) => {
+      setPerf(data as PerformanceData);
+    });
+    emitEvent('setPerformanceMonitoring', { enabled: true });
+
+    return () => {
+      unsub();
+      emitEvent('setPerformanceMonitoring', { enabled: false });
+    };
+  }, []);
+
+  const formatLoad = (value?: number) => (perf && perf.blocks > 0 ? `${(value ?? 0).toFixed(1)}%` : '--');
+
+  const rows: [string, string][] = [
+    ['MIN', formatLoad(perf?.minLoad)],
+    ['MEAN', formatLoad(perf?.meanLoad)],
+    ['P99', formatLoad(perf?.p99Load)],
+    ['MAX', formatLoad(perf?.maxLoad)],
+    ['OVERRUNS', perf ? `${perf.overruns} / ${perf.totalOverruns}` : '--'],
+    ['BLOCKS', perf ? `${perf.blocks}` : '--']
+  ];
+
+  return (
+    <div className="performance">
+      <div className="section-title">PERFORMANCE</div>
+      {rows.map(([label, value]) => (
+        <div className="performance-row" key={label}>
+          <span className="performance-label">{label}</span>
+          <span className={`performance-value ${label === 'OVERRUNS' && perf && perf.overruns > 0 ? 'warning' : ''}`}>
+            {value}
+          </span>
+        </div>
+      ))}
+      <div className="performance-footnote">
+        {perf ? `${perf.kernel} · ${perf.counter}` : 'Waiting for audio...'}
+      </div>
+    </div>
+  );
+}
+
 // ============================================================================
 // Activation Screen
 // ============================================================================
@@ -336,6 +398,9 @@ function PluginUI() {
   // Levels
   const [levels, setLevels] = useState({ input: 0, output: 0 });
 
+  // Performance panel
+  const [showPerformance, setShowPerformance] = useState(false);
+
   useEffect(() => {
     const unsub = addEventListener('visualizerData', (data: unknown) => {
       const d = data as { inputLevel?: number; outputLevel?: number };
@@ -352,14 +417,24 @@ function PluginUI() {
       {/* Header */}
       <header className="header">
         <div className="logo">DELAYWAVE</div>
-        <button
-          className={`bypass-btn ${bypass.value ? 'active' : ''}`}
-          onClick={bypass.toggle}
-        >
-          {bypass.value ? 'BYPASSED' : 'ACTIVE'}
-        </button>
+        <div className="header-buttons">
+          <button
+            className={`bypass-btn ${showPerformance ? 'active' : ''}`}
+            onClick={() => setShowPerformance((shown) => !shown)}
+          >
+            PERF
+          </button>
+          <button
+            className={`bypass-btn ${bypass.value ? 'active' : ''}`}
+            onClick={bypass.toggle}
+          >
+            {bypass.value ? 'BYPASSED' : 'ACTIVE'}
+          </button>
+        </div>
       </header>
 
+      {showPerformance && <PerformancePanel />}
+
       {/* Main controls */}
       <main className="main">
         {/* Meters */}